@@ -0,0 +1,78 @@
+// Standalone benchmark for BitBFST against a full PathFinderT expansion.
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\bitbfs.cpp   (add /arch:AVX2 for the AVX2 numbers)
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <limits>
+
+#include "../paths.hpp"
+#include "../bitbfs.hpp"
+
+namespace {
+  template<typename Fn>
+  double bestOf(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int run = 0; run < runs; ++run) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+  }
+
+  Field randomField(int size, int wallPercent, std::mt19937& rng) {
+    Field field(size, size, '.');
+    for (auto& cell : field.data) {
+      cell = static_cast<int>(rng() % 100) < wallPercent ? '#' : '.';
+    }
+    field[Vector(size / 2, size / 2)] = '.';
+    return field;
+  }
+}
+
+int main() {
+  std::mt19937 rng(5);
+
+  // Step limited query: cells reachable in exactly 327 steps (the AoC 2023 day 21 shape)
+  {
+    constexpr int Size = 655, Steps = 327;
+    auto field = randomField(Size, 15, rng);
+    Vector source(Size / 2, Size / 2);
+    size_t pathFinderCount = 0, bitCount = 0;
+    double pathFinder = bestOf(10, [&] {
+      PathFinder finder(field);
+      finder.findPath(source, Vector(-1, -1), true);
+      pathFinderCount = 0;
+      for (int offset = 0; offset < Size * Size; ++offset) {
+        int cost = finder.workspace->cost(offset);
+        pathFinderCount += cost <= Steps && cost % 2 == Steps % 2;
+      }
+    });
+    double bit = bestOf(10, [&] {
+      BitBFS bfs(field);
+      bfs.run(source, Steps);
+      bitCount = bfs.reachableInExactly(Steps);
+    });
+    printf("%dx%d, 15%% walls, exactly %d steps: PathFinder %.1fms, BitBFS %.1fms (%zu / %zu cells)\n",
+           Size, Size, Steps, pathFinder, bit, pathFinderCount, bitCount);
+  }
+
+  // Full flood, which needs one bit parallel step per layer
+  {
+    constexpr int Size = 2000;
+    auto field = randomField(Size, 15, rng);
+    Vector source(Size / 2, Size / 2);
+    int layers = 0;
+    double pathFinder = bestOf(3, [&] {
+      PathFinder finder(field);
+      finder.findPath(source, Vector(-1, -1), true);
+    });
+    double bit = bestOf(3, [&] {
+      BitBFS bfs(field);
+      layers = bfs.run(source);
+    });
+    printf("%dx%d full flood (%d layers): PathFinder %.1fms, BitBFS %.1fms\n", Size, Size, layers, pathFinder, bit);
+  }
+}
@@ -0,0 +1,21 @@
+@echo off
+rem Builds each benchmark in this directory into bench\build (x64 Native Tools prompt): bench\build.cmd [run]
+rem With "run" each benchmark is executed after the build. cl takes extra options from the CL environment variable (e.g. set CL=/arch:AVX2).
+setlocal enabledelayedexpansion
+cd /d "%~dp0"
+if not exist build mkdir build
+set failed=0
+for %%f in (*.cpp) do (
+  if exist build\%%~nf.exe del build\%%~nf.exe
+  cl /nologo /std:c++latest /O2 /EHsc /Fobuild\ /Febuild\ %%f > build\%%~nf.log
+  if exist build\%%~nf.exe (
+    if /i "%~1"=="run" (
+      echo == %%~nf
+      build\%%~nf.exe || set failed=1
+    )
+  ) else (
+    echo %%~nf: build failed, see bench\build\%%~nf.log
+    set failed=1
+  )
+)
+exit /b !failed!
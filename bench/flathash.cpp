@@ -0,0 +1,63 @@
+// Standalone benchmark for FlatHashMap against std::unordered_map with Vector keys.
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\flathash.cpp
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../vector.hpp"
+#include "../flathash.hpp"
+
+namespace {
+  double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  /** Inserts all keys, looks each one (and two shifted neighbours) up and erases every second key */
+  template<typename Map>
+  void measure(const char* name, const std::vector<Vector>& keys) {
+    Map map;
+    auto start = std::chrono::steady_clock::now();
+    for (auto& key : keys) {
+      map[key] = key.x;
+    }
+    double insert = millisecondsSince(start);
+
+    long long sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int shift = 0; shift < 3; ++shift) {
+      for (auto& key : keys) {
+        auto entry = map.find(key + Vector(shift, 0));
+        if (entry != map.end()) {
+          sum += entry->second;
+        }
+      }
+    }
+    double find = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t index = 0; index < keys.size(); index += 2) {
+      map.erase(keys[index]);
+    }
+    double erase = millisecondsSince(start);
+    printf("%-28s insert %6.1fms, find (3x) %6.1fms, erase (half) %6.1fms (%lld)\n", name, insert, find, erase, sum);
+  }
+}
+
+int main() {
+  // Clustered grid coordinates around the origin in shuffled order
+  std::vector<Vector> keys;
+  for (int y = -350; y < 350; ++y) {
+    for (int x = -350; x < 350; ++x) {
+      keys.emplace_back(x, y);
+    }
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+
+  measure<std::unordered_map<Vector, int>>("unordered_map (std::hash)", keys);
+  measure<std::unordered_map<Vector, int, FlatHash<Vector>>>("unordered_map (FlatHash)", keys);
+  measure<FlatHashMap<Vector, int>>("FlatHashMap", keys);
+}
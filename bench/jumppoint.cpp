@@ -0,0 +1,80 @@
+// Standalone benchmark for JumpPointPathFinderT against PathFinderT.
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\jumppoint.cpp
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+#include "../paths.hpp"
+
+namespace {
+  template<typename Fn>
+  double bestOf(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int run = 0; run < runs; ++run) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+  }
+
+  /** Corner to corner with Dijkstra ordering (findPath) and with A* (findPathAStar) for 4 and 8 directions */
+  void compare(const char* name, Field& field) {
+    Vector from(0, 0), to(field.size.x - 1, field.size.y - 1);
+    for (int y = 0; y < 3; ++y) {
+      for (int x = 0; x < 3; ++x) {
+        field[from + Vector(x, y)] = field[to - Vector(x, y)] = '.';
+      }
+    }
+
+    for (bool diagonal : { false, true }) {
+      PathFinder finder(field);
+      JumpPointPathFinder jumpFinder(field);
+      if (diagonal) {
+        finder.directions = jumpFinder.directions = Vector::AllDirections();
+      }
+      int cost = 0, jumpCost = 0;
+      double dijkstra = bestOf(3, [&] { cost = finder.findPath(from, to); });
+      double jump = bestOf(3, [&] { jumpCost = jumpFinder.findPath(from, to); });
+      double aStar = diagonal ? bestOf(3, [&] { finder.findPathAStar(from, to, heuristic::Chebyshev()); })
+                              : bestOf(3, [&] { finder.findPathAStar(from, to); });
+      double jumpAStar = diagonal ? bestOf(3, [&] { jumpFinder.findPathAStar(from, to, heuristic::Chebyshev()); })
+                                  : bestOf(3, [&] { jumpFinder.findPathAStar(from, to); });
+      printf("%-18s %d directions (cost %d/%d): findPath %.1fms -> JPS %.1fms, findPathAStar %.1fms -> JPS %.1fms\n",
+             name, diagonal ? 8 : 4, cost, jumpCost, dijkstra, jump, aStar, jumpAStar);
+    }
+  }
+}
+
+int main() {
+  std::mt19937 rng(13);
+  constexpr int Size = 1000;
+  char name[32];
+
+  // Single wall cells scattered at random, which give almost every run forced neighbours
+  for (int wallPercent : { 0, 2, 20 }) {
+    Field field(Size, Size, '.');
+    for (auto& cell : field.data) {
+      cell = static_cast<int>(rng() % 100) < wallPercent ? '#' : '.';
+    }
+    snprintf(name, sizeof(name), "%d%% wall cells", wallPercent);
+    compare(name, field);
+  }
+
+  // Open fields with rectangular obstacles of 5x5 to 44x44 cells
+  for (int blocks : { 100, 300, 600 }) {
+    Field field(Size, Size, '.');
+    for (int block = 0; block < blocks; ++block) {
+      Vector corner(rng() % Size, rng() % Size), size(5 + rng() % 40, 5 + rng() % 40);
+      for (int y = corner.y; y < std::min(Size, corner.y + size.y); ++y) {
+        for (int x = corner.x; x < std::min(Size, corner.x + size.x); ++x) {
+          field[Vector(x, y)] = '#';
+        }
+      }
+    }
+    snprintf(name, sizeof(name), "%d blocks", blocks);
+    compare(name, field);
+  }
+}
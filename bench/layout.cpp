@@ -0,0 +1,68 @@
+// Standalone benchmark for the storage layouts of FieldT (row major, tiled, Morton).
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\layout.cpp
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+#include "../paths.hpp"
+
+namespace {
+  template<typename Fn>
+  double bestOf(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int run = 0; run < runs; ++run) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+  }
+
+  /** Scans all rows, all columns and runs a BFS from the top left corner through distanceFields() */
+  template<typename Layout>
+  void measure(const char* name, const Field& scanField, const Field& searchField) {
+    FieldT<char, Layout> field(scanField);
+    long long walls = 0;
+    double rows = bestOf(3, [&] {
+      for (int y = 0; y < field.size.y; ++y) {
+        for (char cell : field.row(y)) {
+          walls += cell == '#';
+        }
+      }
+    });
+    double columns = bestOf(3, [&] {
+      for (int x = 0; x < field.size.x; ++x) {
+        for (char cell : field.column(x)) {
+          walls += cell == '#';
+        }
+      }
+    });
+
+    FieldT<char, Layout> search(searchField);
+    std::vector<Vector> sources = { Vector(0, 0) };
+    int distance = 0;
+    double bfs = bestOf(3, [&] { distance = distanceFields(search, sources)[0][search.bottomRight()]; });
+    printf("%-10s row scan %6.1fms, column scan %6.1fms, BFS %6.1fms (%lld %d)\n", name, rows, columns, bfs, walls, distance);
+  }
+}
+
+int main() {
+  std::mt19937 rng(7);
+  auto randomField = [&](int width, int height) {
+    Field field(width, height, '.');
+    for (auto& cell : field.data) {
+      cell = rng() % 100 < 15 ? '#' : '.';
+    }
+    field[Vector(0, 0)] = '.';
+    return field;
+  };
+  auto scanField = randomField(16000, 4000);
+  auto searchField = randomField(10000, 1000);
+
+  measure<layout::RowMajor>("row major", scanField, searchField);
+  measure<layout::Tiled<16>>("tiled16", scanField, searchField);
+  measure<layout::Tiled<64>>("tiled64", scanField, searchField);
+  measure<layout::Morton>("morton", scanField, searchField);
+}
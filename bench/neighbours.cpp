@@ -0,0 +1,87 @@
+// Standalone benchmark for the neighbour iteration of vector.hpp and the expansion of PathFinderT.
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\neighbours.cpp
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <initializer_list>
+
+#include "../paths.hpp"
+
+namespace {
+  template<typename Fn>
+  double bestOf(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int run = 0; run < runs; ++run) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+  }
+
+  /** The direction list as it was before the compile time tables */
+  const std::initializer_list<const Vector>& runtimeDirections() {
+    static const std::initializer_list<const Vector> directions = {
+      Vector::Up, Vector::UpRight, Vector::Right, Vector::DownRight, Vector::Down, Vector::DownLeft, Vector::Left, Vector::UpLeft
+    };
+    return directions;
+  }
+}
+
+int main() {
+  std::mt19937 rng(1);
+  constexpr int Size = 2000;
+  Field field(Size, Size, '.');
+  for (auto& cell : field.data) {
+    cell = rng() % 3 == 0 ? '#' : '.';
+  }
+  Field padded(field, 1, '.');
+
+  // Counts the walls around every cell
+  long long count = 0;
+  double loop = bestOf(5, [&] {
+    for (int y = 0; y < Size; ++y) {
+      for (int x = 0; x < Size; ++x) {
+        for (auto direction : runtimeDirections()) {
+          count += padded[Vector(x, y) + direction] == '#';
+        }
+      }
+    }
+  });
+  double unrolled = bestOf(5, [&] {
+    for (int y = 0; y < Size; ++y) {
+      for (int x = 0; x < Size; ++x) {
+        forEachNeighbour<8>(Vector(x, y), [&](const Vector& neighbour) { count += padded[neighbour] == '#'; });
+      }
+    }
+  });
+  auto deltas = padded.neighbourDeltas<8>();
+  double offsets = bestOf(5, [&] {
+    for (int y = 0; y < Size; ++y) {
+      int offset = padded.toOffset(Vector(0, y));
+      for (int x = 0; x < Size; ++x, ++offset) {
+        forEachNeighbour(offset, deltas, [&](int neighbour) { count += padded.data[neighbour] == '#'; });
+      }
+    }
+  });
+  printf("8-neighbour wall count %dx%d: runtime loop %.1fms, forEachNeighbour<8> %.1fms, offset deltas %.1fms (%lld)\n",
+         Size, Size, loop, unrolled, offsets, count);
+
+  // Full expansion of PathFinderT, whose neighbour loop stays a runtime loop over directions
+  Field maze(1000, 1000, '.');
+  for (auto& cell : maze.data) {
+    cell = rng() % 4 == 0 ? '#' : '.';
+  }
+  maze[Vector(0, 0)] = maze[Vector(999, 999)] = '.';
+  for (bool diagonal : { false, true }) {
+    PathFinder finder(maze);
+    if (diagonal) {
+      finder.directions = Vector::AllDirections();
+    }
+    int cost = 0;
+    double time = bestOf(7, [&] { cost = finder.findPath(Vector(0, 0), Vector(999, 999), true); });
+    printf("PathFinder %d directions 1000x1000: %.1fms (cost %d)\n", diagonal ? 8 : 4, time, cost);
+  }
+}
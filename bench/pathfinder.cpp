@@ -0,0 +1,104 @@
+// Standalone benchmark for the bucket queue and dense cost array of PathFinderT against the former
+// std::set + std::unordered_map expansion.
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\pathfinder.cpp
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <set>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <unordered_map>
+
+#include "../paths.hpp"
+
+namespace {
+  template<typename Fn>
+  double bestOf(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int run = 0; run < runs; ++run) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+  }
+
+  /** The expansion of PathFinderT as it was before the bucket queue: an ordered set as priority queue
+   *  and a hash map for the costs
+   */
+  struct SetMapPathFinder {
+    struct ExpandEntry {
+      std::strong_ordering operator<=>(const ExpandEntry& other) const {
+        auto result = cost <=> other.cost;
+        return result == std::strong_ordering::equal ? position <=> other.position : result;
+      }
+
+      Vector position;
+      int cost;
+    };
+
+    int findPath(Vector from, Vector to, bool expandAllFields) {
+      costMap.clear();
+      std::set<ExpandEntry> expandList = { { from, 0 } };
+      int pathCost = -1;
+      while (!expandList.empty()) {
+        auto entry = *expandList.begin();
+        expandList.erase(expandList.begin());
+
+        auto [pos, inserted] = costMap.emplace(entry.position, entry.cost);
+        if (!inserted) {
+          if (pos->second <= entry.cost) {
+            continue;
+          }
+          pos->second = entry.cost;
+        }
+
+        if (entry.position == to) {
+          if (!expandAllFields) {
+            return entry.cost;
+          }
+          pathCost = entry.cost;
+        }
+
+        for (auto direction : Vector::AllSimpleDirections()) {
+          auto nextPosition = entry.position + direction;
+          if (field.validPosition(nextPosition) && field[nextPosition] != '#') {
+            expandList.insert({ nextPosition, entry.cost + 1 });
+          }
+        }
+      }
+      return pathCost;
+    }
+
+    const Field& field;
+    std::unordered_map<Vector, int> costMap;
+  };
+}
+
+int main() {
+  std::mt19937 rng(7);
+  constexpr int Size = 2000;
+  Vector from(0, 0), to(Size - 1, Size - 1);
+
+  for (int wallPercent : { 0, 15, 25 }) {
+    Field field(Size, Size, '.');
+    for (auto& cell : field.data) {
+      cell = static_cast<int>(rng() % 100) < wallPercent ? '#' : '.';
+    }
+    for (int y = 0; y < 3; ++y) {
+      for (int x = 0; x < 3; ++x) {
+        field[from + Vector(x, y)] = field[to - Vector(x, y)] = '.'; // keep the corners connected
+      }
+    }
+
+    for (bool expandAllFields : { false, true }) {
+      SetMapPathFinder setMap{ field };
+      PathFinder finder(field);
+      int setMapCost = 0, cost = 0;
+      double before = bestOf(3, [&] { setMapCost = setMap.findPath(from, to, expandAllFields); });
+      double after = bestOf(3, [&] { cost = finder.findPath(from, to, expandAllFields); });
+      printf("%2d%% walls %dx%d, %s (cost %d/%d): set+map %.1fms -> bucket+dense %.1fms (%.1fx)\n",
+             wallPercent, Size, Size, expandAllFields ? "full expansion" : "to target     ", setMapCost, cost, before, after, before / after);
+    }
+  }
+}
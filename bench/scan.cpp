@@ -0,0 +1,51 @@
+// Standalone benchmark for the vectorized scans of FieldT (count, positionsOf, classify).
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\scan.cpp   (add /arch:AVX2 for the AVX2 numbers)
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+
+#include "../field.hpp"
+
+namespace {
+  template<typename Fn>
+  double bestOf(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int run = 0; run < runs; ++run) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+  }
+}
+
+int main() {
+  std::mt19937 rng(1);
+  constexpr int Size = 4000;
+  Field field(Size, Size, '.');
+  for (auto& cell : field.data) {
+    cell = rng() % 50 == 0 ? '#' : '.';
+  }
+
+  std::vector<Vector> loopPositions, scanPositions;
+  double findLoop = bestOf(5, [&] {
+    loopPositions.clear();
+    for (size_t offset = field.findOffset('#'); offset != std::numeric_limits<size_t>::max(); offset = field.findOffset('#', offset + 1)) {
+      loopPositions.push_back(field.fromOffset(static_cast<int>(offset)));
+    }
+  });
+  double positions = bestOf(5, [&] { scanPositions = field.positionsOf('#'); });
+
+  size_t stdCount = 0, scanCount = 0;
+  double countLoop = bestOf(5, [&] { stdCount = std::count(field.data.begin(), field.data.end(), '#'); });
+  double count = bestOf(5, [&] { scanCount = field.count('#'); });
+  double classify = bestOf(5, [&] { field.classify({ '#', '.' }); });
+
+  printf("%dx%d field, 2%% '#': findOffset loop %.1fms -> positionsOf %.1fms (%s)\n", Size, Size, findLoop, positions,
+         loopPositions == scanPositions ? "same positions" : "MISMATCH");
+  printf("std::count %.1fms -> count %.1fms (%zu / %zu), classify of 2 elements %.1fms\n", countLoop, count, stdCount, scanCount, classify);
+}
@@ -0,0 +1,133 @@
+// Standalone benchmark for KdTreeT and SpatialGridT against brute force loops over all pairs of points.
+// Build (x64 Native Tools prompt): cl /std:c++latest /O2 /EHsc bench\spatial.cpp
+// bench\build.cmd builds all benchmarks into bench\build (bench\build.cmd run also runs them).
+
+#include <tuple>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+
+#include "../vector3d.hpp"
+#include "../spatial.hpp"
+
+namespace {
+  double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  using Point = VectorT3D<int>;
+  using PointPair = spatial::PointPairT<int64_t>;
+
+  std::vector<Point> randomPoints(int count, std::mt19937& rng) {
+    std::vector<Point> points;
+    for (int index = 0; index < count; ++index) {
+      points.emplace_back(rng() % 100000, rng() % 100000, rng() % 100000);
+    }
+    return points;
+  }
+
+  /** Sum of the distances of the first count pairs, which is compared between the methods */
+  template<typename Index>
+  int64_t closestPairs(const Index& index, int count) {
+    auto pairs = index.closestPairs();
+    int64_t sum = 0;
+    for (int pair = 0; pair < count; ++pair) {
+      sum += pairs.next()->distance;
+    }
+    return sum;
+  }
+}
+
+int main() {
+  std::mt19937 rng(3);
+
+  // The n closest pairs (e.g. connecting the closest junction boxes) and the nearest neighbour of every point
+  for (int count : { 1000, 4000 }) {
+    auto points = randomPoints(count, rng);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<PointPair> pairs;
+    pairs.reserve(static_cast<size_t>(count) * (count - 1) / 2);
+    for (int first = 0; first < count; ++first) {
+      for (int second = first + 1; second < count; ++second) {
+        pairs.push_back(PointPair{ first, second, spatial::squaredDistance(points[first], points[second]) });
+      }
+    }
+    std::partial_sort(pairs.begin(), pairs.begin() + count, pairs.end(), [](const PointPair& a, const PointPair& b) {
+      return std::tie(a.distance, a.first, a.second) < std::tie(b.distance, b.first, b.second);
+    });
+    int64_t bruteSum = 0;
+    for (int pair = 0; pair < count; ++pair) {
+      bruteSum += pairs[pair].distance;
+    }
+    double brute = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    int64_t treeSum = closestPairs(KdTree3D(points), count);
+    double tree = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    int64_t gridSum = closestPairs(SpatialGrid3D(points), count);
+    double grid = millisecondsSince(start);
+    printf("n=%d, first %d pairs: brute force %.1fms, k-d tree %.1fms, grid %.1fms (%s)\n", count, count, brute, tree, grid,
+           bruteSum == treeSum && bruteSum == gridSum ? "same pairs" : "MISMATCH");
+
+    start = std::chrono::steady_clock::now();
+    int64_t bruteNearest = 0;
+    for (int index = 0; index < count; ++index) {
+      int64_t best = std::numeric_limits<int64_t>::max();
+      for (int other = 0; other < count; ++other) {
+        if (other != index) {
+          best = std::min(best, spatial::squaredDistance(points[index], points[other]));
+        }
+      }
+      bruteNearest += best;
+    }
+    brute = millisecondsSince(start);
+
+    KdTree3D kdTree(points);
+    SpatialGrid3D spatialGrid(points);
+    int64_t treeNearest = 0, gridNearest = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto& point : points) {
+      treeNearest += kdTree.nearest(point, 2)[1].distance;
+    }
+    tree = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (auto& point : points) {
+      gridNearest += spatialGrid.nearest(point, 2)[1].distance;
+    }
+    grid = millisecondsSince(start);
+    printf("n=%d, nearest neighbour of every point: brute force %.1fms, k-d tree %.1fms, grid %.1fms (%s)\n", count, brute, tree, grid,
+           bruteNearest == treeNearest && bruteNearest == gridNearest ? "same distances" : "MISMATCH");
+  }
+
+  // Too many points to materialize all pairs
+  {
+    constexpr int Count = 50000;
+    auto points = randomPoints(Count, rng);
+    auto start = std::chrono::steady_clock::now();
+    int64_t closest = std::numeric_limits<int64_t>::max();
+    for (int first = 0; first < Count; ++first) {
+      for (int second = first + 1; second < Count; ++second) {
+        closest = std::min(closest, spatial::squaredDistance(points[first], points[second]));
+      }
+    }
+    double brute = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    KdTree3D tree(points);
+    auto treePairs = tree.closestPairs();
+    bool same = treePairs.next()->distance == closest;
+    for (int pair = 1; pair < Count; ++pair) {
+      treePairs.next();
+    }
+    double treeTime = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    closestPairs(SpatialGrid3D(points), Count);
+    double gridTime = millisecondsSince(start);
+    printf("n=%d: closest pair by brute force %.0fms, first %d pairs with k-d tree %.0fms, grid %.0fms (%s)\n",
+           Count, brute, Count, treeTime, gridTime, same ? "same closest pair" : "MISMATCH");
+  }
+}
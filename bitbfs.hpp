@@ -0,0 +1,165 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "field.hpp"
+#include "bitfield.hpp"
+
+/** Bit parallel breadth first search for unit cost 4-neighbour moves on a field (walls are '#').
+ *  The cells are stored as BitFields and the whole frontier is advanced at once by shifting the
+ *  rows left/right/up/down and masking with the open cells, which expands 64 cells per word operation.
+ *  The plain word loops are simple enough to be auto vectorized by the compiler for wide fields.
+ */
+template<typename T>
+struct BitBFST {
+  BitBFST(const FieldT<T>& field) : size(field.size), open(field, [](const T& cell) { return cell != '#'; }), words(open.rowWords) {}
+
+
+  int run(Vector source, int maxSteps = std::numeric_limits<int>::max(), FieldT<int>* distances = nullptr) {
+    return run(std::span<const Vector>(&source, 1), maxSteps, distances);
+  }
+
+  /** Expands from all sources until no new cells are reached or maxSteps is reached and returns the number of steps
+   *  taken. Afterwards layerSizes[d] contains the number of cells with distance d and reached contains all visited cells.
+   *  If distances is given, it is filled with the distance to each cell (-1 for unreached cells).
+   */
+  int run(std::span<const Vector> sources, int maxSteps = std::numeric_limits<int>::max(), FieldT<int>* distances = nullptr) {
+    reached = frontier = next = BitField(size.x, size.y);
+    layerSizes.clear();
+    stuckCells = { 0, 0 };
+    if (distances) {
+      *distances = FieldT<int>(size.x, size.y, -1);
+    }
+
+    for (auto& source : sources) {
+      if (frontier.validPosition(source)) {
+        frontier[source] = true;
+      }
+    }
+
+    // Sources are reached even if they are walls
+    Bounds bounds{ 0, size.y - 1, 0, words - 1 };
+    int steps = 0;
+    for (size_t layerSize = recordLayer(bounds, steps, distances); layerSize > 0 && steps < maxSteps; ) {
+      // Only the bounding box of the frontier grown by one cell (word) can contain new cells
+      bounds = { std::max(bounds.minY - 1, 0), std::min(bounds.maxY + 1, size.y - 1),
+                 std::max(bounds.minWord - 1, 0), std::min(bounds.maxWord + 1, words - 1) };
+      for (int y = bounds.minY; y <= bounds.maxY; ++y) {
+        for (int word = bounds.minWord; word <= bounds.maxWord; ++word) {
+          auto cells = frontier.words[index(y, word)];
+          auto left = (cells >> 1) | (word + 1 < words ? frontier.words[index(y, word + 1)] << 63 : 0);
+          auto right = (cells << 1) | (word > 0 ? frontier.words[index(y, word - 1)] >> 63 : 0);
+          auto up = y + 1 < size.y ? frontier.words[index(y + 1, word)] : 0;
+          auto down = y > 0 ? frontier.words[index(y - 1, word)] : 0;
+          next.words[index(y, word)] = (left | right | up | down) & open.words[index(y, word)] & ~reached.words[index(y, word)];
+        }
+      }
+      // The old frontier lies within bounds and must not leak into the next step, which may use smaller bounds
+      std::swap(frontier, next);
+      clear(next, bounds);
+      ++steps;
+      layerSize = recordLayer(bounds, steps, distances);
+      if (layerSize == 0) {
+        layerSizes.pop_back(); // the search ended without reaching anything new
+        --steps;
+      }
+    }
+
+    return steps;
+  }
+
+  /** Returns the number of cells in which a walk of exactly the given number of steps from the sources can end.
+   *  A cell reached with fewer steps of the same parity is reached again by stepping back and forth to an open
+   *  neighbour, unless the walk cannot leave it and return (see stuckCells).
+   */
+  size_t reachableInExactly(int steps) const {
+    if (steps < 0) {
+      return 0;
+    }
+    size_t count = 0;
+    for (int distance = steps % 2; distance < static_cast<int>(layerSizes.size()) && distance <= steps; distance += 2) {
+      count += layerSizes[distance] - (distance < steps && distance < 2 ? stuckCells[distance] : 0);
+    }
+    return count;
+  }
+
+  /** Returns the number of cells reachable with at most the given number of steps
+   */
+  size_t reachableWithin(int steps) const {
+    size_t count = 0;
+    for (int distance = 0; distance < static_cast<int>(layerSizes.size()) && distance <= steps; ++distance) {
+      count += layerSizes[distance];
+    }
+    return count;
+  }
+
+  bool isReached(const Vector& pos) const { return reached[pos]; }
+
+
+  Vector size;
+  BitField open, reached, frontier, next;
+  int words; // 64 bit words per row
+  std::vector<size_t> layerSizes;
+  /** Number of cells with distance 0 and 1, which a walk can only end in at exactly that distance: sources which are
+   *  walls or have no open neighbour and cells without open neighbours next to wall sources. Cells further away always
+   *  have an open predecessor to step back to.
+   */
+  std::array<size_t, 2> stuckCells = { 0, 0 };
+
+private:
+  size_t index(int y, int word) const { return static_cast<size_t>(y) * words + word; }
+
+  struct Bounds {
+    int minY, maxY, minWord, maxWord;
+  };
+
+  void clear(BitField& layer, const Bounds& bounds) {
+    for (int y = bounds.minY; y <= bounds.maxY; ++y) {
+      for (int word = bounds.minWord; word <= bounds.maxWord; ++word) {
+        layer.words[index(y, word)] = 0;
+      }
+    }
+  }
+
+  /** Marks the frontier within bounds as reached, appends its size to layerSizes and writes the distances if requested.
+   *  The bounds are shrunk to the bounding box of the frontier.
+   */
+  size_t recordLayer(Bounds& bounds, int distance, FieldT<int>* distances) {
+    Bounds frontierBounds{ size.y, -1, words, -1 };
+    size_t layerSize = 0;
+    for (int y = bounds.minY; y <= bounds.maxY; ++y) {
+      for (int word = bounds.minWord; word <= bounds.maxWord; ++word) {
+        auto cells = frontier.words[index(y, word)];
+        if (cells == 0) {
+          continue;
+        }
+        frontierBounds = { std::min(frontierBounds.minY, y), std::max(frontierBounds.maxY, y),
+                           std::min(frontierBounds.minWord, word), std::max(frontierBounds.maxWord, word) };
+        reached.words[index(y, word)] |= cells;
+        layerSize += std::popcount(cells);
+        if (distance < 2) {
+          for (auto stuck = cells; stuck != 0; stuck &= stuck - 1) {
+            Vector position(word * 64 + std::countr_zero(stuck), y);
+            bool openNeighbour = false;
+            forEachNeighbour(position, [&](const Vector& neighbour) { openNeighbour |= open.at(neighbour, false); });
+            stuckCells[distance] += !openNeighbour || !open[position];
+          }
+        }
+        if (distances) {
+          for (; cells != 0; cells &= cells - 1) {
+            (*distances)[Vector(word * 64 + std::countr_zero(cells), y)] = distance;
+          }
+        }
+      }
+    }
+    bounds = frontierBounds;
+    layerSizes.push_back(layerSize);
+    return layerSize;
+  }
+};
+
+using BitBFS = BitBFST<char>;
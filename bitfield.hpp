@@ -0,0 +1,275 @@
+#pragma once
+
+#include <bit>
+#include <limits>
+#include <vector>
+#include <ranges>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+
+#include "field.hpp"
+
+/** Bit packed two dimensional field of booleans (e.g. visited sets, wall masks or cellular automata).
+ *  Each row is stored as a sequence of 64 bit words with the bits beyond size.x always being zero, so whole field
+ *  operations (and/or/xor/not, shifts, popcount, scans) work on 64 cells at once. The word loops are kept simple
+ *  enough for the compiler to vectorize them.
+ *  Offsets and positions have the same meaning as in FieldT.
+ */
+struct BitField {
+  using Word = uint64_t;
+  static constexpr int WordBits = 64;
+
+  /** Proxy for a single bit returned by the non const operator[]
+   */
+  struct reference {
+    operator bool() const { return (*word >> bit) & 1; }
+    reference& operator=(bool value) {
+      *word = value ? (*word | (Word(1) << bit)) : (*word & ~(Word(1) << bit));
+      return *this;
+    }
+    reference& operator=(const reference& other) { return *this = static_cast<bool>(other); }
+
+    Word* word;
+    int bit;
+  };
+
+  BitField(int width = 0, int height = 0, bool fill = false) : size(width, height), rowWords((width + WordBits - 1) / WordBits) {
+    words.assign(static_cast<size_t>(rowWords) * height, 0);
+    if (fill) {
+      invert();
+    }
+  }
+
+  /** Creates a bit field with all cells set, for which predicate(field[pos]) holds
+   */
+  template<typename Element, typename Layout, typename Predicate>
+  BitField(const FieldT<Element, Layout>& field, Predicate predicate) : BitField(field.size.x, field.size.y) {
+    for (int y = 0; y < size.y; ++y) {
+      for (int word = 0; word < rowWords; ++word) {
+        Word bits = 0;
+        for (int bit = 0, x = word * WordBits; bit < WordBits && x < size.x; ++bit, ++x) {
+          bits |= Word(predicate(field[Vector(x, y)]) ? 1 : 0) << bit;
+        }
+        words[index(y, word)] = bits;
+      }
+    }
+  }
+
+  /** Creates a bit field with all cells set, which contain the given element
+   */
+  template<typename Element, typename Layout>
+  BitField(const FieldT<Element, Layout>& field, const Element& element) : BitField(field, [&](const Element& value) { return value == element; }) {}
+
+
+  reference operator[](const Vector& pos) { return { &words[wordIndex(pos)], pos.x % WordBits }; }
+  bool operator[](const Vector& pos) const { return (words[wordIndex(pos)] >> (pos.x % WordBits)) & 1; }
+  bool validPosition(const Vector& pos) const { return pos.x >= 0 && pos.y >= 0 && pos.x < size.x && pos.y < size.y; }
+  bool isAt(bool value, const Vector& pos) const { return validPosition(pos) && (*this)[pos] == value; }
+  bool at(const Vector& pos, bool defaultValue) const { return validPosition(pos) ? (*this)[pos] : defaultValue; }
+
+  int toOffset(const Vector& pos) const { return pos.y * size.x + pos.x; }
+  Vector fromOffset(size_t offset) const { return Vector(static_cast<int>(offset) % size.x, static_cast<int>(offset) / size.x); }
+
+  /** Returns the cells x..x+63 of the given row as bits (bit i is the cell x+i), where cells outside of the field are 0.
+   *  This allows scanning a row from any position 64 cells at a time.
+   */
+  Word bitsAt(int row, int x) const {
+    if (row < 0 || row >= size.y || x >= size.x || x <= -WordBits) {
+      return 0;
+    }
+    int word = x >= 0 ? x / WordBits : -1;
+    int shift = x - word * WordBits;
+    Word low = word >= 0 ? words[index(row, word)] : 0;
+    Word high = word + 1 < rowWords ? words[index(row, word + 1)] : 0;
+    return shift == 0 ? low : (low >> shift) | (high << (WordBits - shift));
+  }
+
+  /** Returns the offset of the first cell at or after startOffset with the given value (or the max. size_t value if there is none)
+   */
+  size_t findOffset(bool value = true, size_t startOffset = 0) const {
+    if (size.x <= 0) {
+      return std::numeric_limits<size_t>::max(); // empty field, which fromOffset() cannot map to a position
+    }
+    for (auto pos = fromOffset(startOffset); pos.y < size.y; pos = Vector(0, pos.y + 1)) {
+      for (int word = pos.x / WordBits; word < rowWords; ++word) {
+        auto bits = (value ? words[index(pos.y, word)] : ~words[index(pos.y, word)]) & validBits(word);
+        if (word == pos.x / WordBits) {
+          bits &= ~Word(0) << (pos.x % WordBits); // ignore the bits before startOffset
+        }
+        if (bits != 0) {
+          return toOffset(Vector(word * WordBits + std::countr_zero(bits), pos.y));
+        }
+      }
+    }
+    return std::numeric_limits<size_t>::max();
+  }
+
+  /** Number of set cells
+   */
+  size_t count() const {
+    size_t result = 0;
+    for (auto word : words) {
+      result += std::popcount(word);
+    }
+    return result;
+  }
+
+  bool any() const { return std::ranges::any_of(words, [](Word word) { return word != 0; }); }
+
+  /** Calls fn(pos) for each set cell in row major order
+   */
+  template<typename Fn>
+  void forEachSet(Fn&& fn) const {
+    for (int y = 0; y < size.y; ++y) {
+      for (int word = 0; word < rowWords; ++word) {
+        for (auto bits = words[index(y, word)]; bits != 0; bits &= bits - 1) {
+          fn(Vector(word * WordBits + std::countr_zero(bits), y));
+        }
+      }
+    }
+  }
+
+  // Returns the range of the i'th row (0-based) left to right
+  auto row(int row) {
+    return std::views::iota(0, size.x) | std::views::transform([this, row](int x) { return (*this)[Vector(x, row)]; });
+  }
+
+  auto row(int row) const {
+    return std::views::iota(0, size.x) | std::views::transform([this, row](int x) { return (*this)[Vector(x, row)]; });
+  }
+
+
+  BitField& operator&=(const BitField& other) { return combine(other, [](Word a, Word b) { return a & b; }); }
+  BitField& operator|=(const BitField& other) { return combine(other, [](Word a, Word b) { return a | b; }); }
+  BitField& operator^=(const BitField& other) { return combine(other, [](Word a, Word b) { return a ^ b; }); }
+  /** Removes all cells set in other */
+  BitField& operator-=(const BitField& other) { return combine(other, [](Word a, Word b) { return a & ~b; }); }
+
+  BitField operator&(const BitField& other) const { auto copy = *this; return copy &= other; }
+  BitField operator|(const BitField& other) const { auto copy = *this; return copy |= other; }
+  BitField operator^(const BitField& other) const { auto copy = *this; return copy ^= other; }
+  BitField operator-(const BitField& other) const { auto copy = *this; return copy -= other; }
+  BitField operator~() const { auto copy = *this; return copy.invert(); }
+
+  /** Flips all cells in place
+   */
+  BitField& invert() {
+    for (int y = 0; y < size.y; ++y) {
+      for (int word = 0; word < rowWords; ++word) {
+        words[index(y, word)] = ~words[index(y, word)] & validBits(word);
+      }
+    }
+    return *this;
+  }
+
+  /** Returns a copy, in which each cell is moved by offset (result[pos + offset] = (*this)[pos]).
+   *  Cells moved out of the field are dropped and the uncovered cells are cleared.
+   */
+  BitField shifted(const Vector& offset) const {
+    BitField result(size.x, size.y);
+    for (int y = std::max(0, offset.y); y < std::min(size.y, size.y + offset.y); ++y) {
+      shiftRow(&words[index(y - offset.y, 0)], &result.words[index(y, 0)], offset.x);
+    }
+    return result;
+  }
+
+  /** Returns a copy with rows and columns swapped (result[Vector(y, x)] = (*this)[Vector(x, y)]), so that columns
+   *  can be scanned with the row operations.
+   */
+  BitField transposed() const {
+    BitField result(size.y, size.x);
+    Word block[WordBits];
+    for (int y = 0; y < size.y; y += WordBits) {
+      for (int word = 0; word < rowWords; ++word) {
+        for (int row = 0; row < WordBits; ++row) {
+          block[row] = y + row < size.y ? words[index(y + row, word)] : 0;
+        }
+        transpose(block);
+        for (int column = 0; column < WordBits && word * WordBits + column < size.x; ++column) {
+          result.words[result.index(word * WordBits + column, y / WordBits)] = block[column];
+        }
+      }
+    }
+    return result;
+  }
+
+  bool operator==(const BitField& other) const = default;
+
+
+  Vector size;
+  int rowWords; // words per row
+  std::vector<Word> words;
+
+private:
+  size_t index(int y, int word) const { return static_cast<size_t>(y) * rowWords + word; }
+  size_t wordIndex(const Vector& pos) const { return index(pos.y, pos.x / WordBits); }
+
+  /** Mask of the bits within the given word of a row, which belong to the field
+   */
+  Word validBits(int word) const {
+    int bits = size.x - word * WordBits;
+    return bits >= WordBits ? ~Word(0) : (Word(1) << bits) - 1;
+  }
+
+  template<typename Op>
+  BitField& combine(const BitField& other, Op op) {
+    for (size_t word = 0; word < words.size(); ++word) {
+      words[word] = op(words[word], other.words[word]);
+    }
+    return *this;
+  }
+
+  /** Transposes a 64x64 bit matrix in place (bit column of block[row] becomes bit row of block[column])
+   *  by swapping ever smaller off diagonal sub blocks.
+   */
+  static void transpose(Word* block) {
+    Word mask = 0x00000000FFFFFFFF;
+    for (int width = WordBits / 2; width != 0; width >>= 1, mask ^= mask << width) {
+      for (int row = 0; row < WordBits; row = ((row | width) + 1) & ~width) {
+        Word swap = ((block[row] >> width) ^ block[row | width]) & mask;
+        block[row | width] ^= swap;
+        block[row] ^= swap << width;
+      }
+    }
+  }
+
+  /** Writes the source row moved by dx bits (positive to the right) into the destination row
+   */
+  void shiftRow(const Word* source, Word* destination, int dx) const {
+    int wordShift = (dx >= 0 ? dx : -dx) / WordBits;
+    int bitShift = (dx >= 0 ? dx : -dx) % WordBits;
+    for (int word = 0; word < rowWords; ++word) {
+      Word value = 0;
+      if (dx >= 0) {
+        int from = word - wordShift;
+        if (from >= 0) {
+          value = source[from] << bitShift;
+          if (bitShift != 0 && from > 0) {
+            value |= source[from - 1] >> (WordBits - bitShift);
+          }
+        }
+      } else {
+        int from = word + wordShift;
+        if (from < rowWords) {
+          value = source[from] >> bitShift;
+          if (bitShift != 0 && from + 1 < rowWords) {
+            value |= source[from + 1] << (WordBits - bitShift);
+          }
+        }
+      }
+      destination[word] = value & validBits(word);
+    }
+  }
+};
+
+
+inline std::ostream& operator<<(std::ostream& out, const BitField& field) {
+  for (int y = 0; y < field.size.y; ++y) {
+    for (int x = 0; x < field.size.x; ++x) {
+      out << (field[Vector(x, y)] ? '#' : '.');
+    }
+    out << "\n";
+  }
+  return out;
+}
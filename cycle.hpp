@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "flathash.hpp"
+
+/** A cycle in a sequence of states x(0), x(1), ... where x(start + length) == x(start) is the first repetition
+ */
+struct Cycle {
+  /** Returns the earlier iteration, which has the same state as the given (possibly huge) iteration */
+  size_t equivalent(size_t iteration) const {
+    return iteration < start ? iteration : start + (iteration - start) % length;
+  }
+
+  size_t start;
+  size_t length;
+};
+
+
+/** Fingerprint indexed history of a sequence of states. Feed the fingerprint of each state in order into add(), which returns
+ *  the cycle as soon as a fingerprint repeats. Afterwards fingerprints[cycle.equivalent(n)] identifies the state n and the
+ *  caller may keep its own per iteration results (e.g. scores) to answer for huge n without simulating further.
+ */
+struct CycleDetector {
+  std::optional<Cycle> add(uint64_t fingerprint) {
+    auto [entry, inserted] = firstSeen.emplace(fingerprint, fingerprints.size());
+    fingerprints.push_back(fingerprint);
+    if (inserted) {
+      return std::nullopt;
+    }
+    return Cycle{ entry->second, fingerprints.size() - 1 - entry->second };
+  }
+
+  /** Number of states added so far */
+  size_t size() const { return fingerprints.size(); }
+
+  void clear() {
+    fingerprints.clear();
+    firstSeen.clear();
+  }
+
+  std::vector<uint64_t> fingerprints; // fingerprint of each added state in order
+private:
+  FlatHashMap<uint64_t, size_t> firstSeen; // fingerprint -> first index
+};
+
+
+/** Brent's cycle detection for the sequence start, step(start), step(step(start)), ... which only keeps two states in memory.
+ *  States are compared by their fingerprint(state). Returns the cycle after about start + 2 * length calls of step().
+ */
+template<typename State, typename Step, typename Fingerprint>
+Cycle findCycle(const State& start, Step&& step, Fingerprint&& fingerprint) {
+  // Find the cycle length by moving the tortoise to the hare at each power of two
+  size_t power = 1, length = 1;
+  State tortoise = start;
+  State hare = step(start);
+  uint64_t tortoiseHash = fingerprint(tortoise);
+  while (tortoiseHash != fingerprint(hare)) {
+    if (power == length) {
+      tortoise = hare;
+      tortoiseHash = fingerprint(tortoise);
+      power *= 2;
+      length = 0;
+    }
+    hare = step(hare);
+    ++length;
+  }
+
+  // Find the cycle start by moving both with the distance of length until they meet
+  tortoise = start;
+  hare = start;
+  for (size_t i = 0; i < length; ++i) {
+    hare = step(hare);
+  }
+  size_t first = 0;
+  while (fingerprint(tortoise) != fingerprint(hare)) {
+    tortoise = step(tortoise);
+    hare = step(hare);
+    ++first;
+  }
+  return Cycle{ first, length };
+}
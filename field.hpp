@@ -1,13 +1,21 @@
 #pragma once
 
+#include <array>
 #include <ranges>
 #include <iterator>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <optional>
+#include <initializer_list>
+#include <span>
+#include <algorithm>
+#include <cstdint>
+#include <bit>
+#include <type_traits>
 
 #include "vector.hpp"
+#include "scan.hpp"
 
 int int_div_round(int numerator, int denominator) {
   // perform rounding with integer division by calculating floor(numerator/denominator + 1/2)
@@ -26,81 +34,42 @@ int int_div_ceil(int numerator, int denominator) {
 }
 
 
-template<typename Element>
-struct FieldT {
-  FieldT(int width, int height, Element fill) : size(width, height) {
-    data.resize(width * height, fill);
-  }
-
-  FieldT(std::istream&& source) : FieldT(source) {}
-  FieldT(std::istream& source) : size(0, 0) {
-    for (std::string line; std::getline(source, line);) {
-      if (line.empty()) { // special case for Day 15 where the field is followed by a newline and instructions
-        break;
-      }
-      for (char ch : line) {
-        data.emplace_back(ch); // Element must be constructible from a single char
-      }
-      size.x = static_cast<int>(line.length());
-      ++size.y;
-    }
-  }
-
-  template<typename Self>
-  auto& operator[](this Self&& self, const Vector& pos) { return self.data[self.toOffset(pos)]; }
-  bool validPosition(const Vector& pos) const { return pos.x >= 0 && pos.y >= 0 && pos.x < size.x && pos.y < size.y; }
-  bool isAt(const Element& element, const Vector& pos) const { return validPosition(pos) && (*this)[pos] == element; }
-  /** checked field access, which returns a copy to the field value if the position is valid */
-  std::optional<Element> at(const Vector& pos) const { return validPosition(pos) ? std::optional<Element>(data[toOffset(pos)]) : std::nullopt; }
-  Element at(const Vector& pos, Element defaultValue) const { return validPosition(pos) ? data[toOffset(pos)] : defaultValue; }
-
-  int toOffset(const Vector& pos) const { return pos.y * size.x + pos.x; }
-  Vector fromOffset(size_t offset) const { return Vector(static_cast<int>(offset) % size.x, static_cast<int>(offset) / size.x); }
-  size_t findOffset(const Element& element, size_t startOffset = 0) const {
-    auto pos = std::find(data.begin() + startOffset, data.end(), element);
-    return pos != data.end() ? std::distance(data.begin(), pos) : std::numeric_limits<size_t>::max();
-  }
-  
-  Vector topLeft() const { return Vector(0, 0); }
-  Vector topRight() const { return Vector(size.x - 1, 0); }
-  Vector bottomLeft() const { return Vector(0, size.y - 1); }
-  Vector bottomRight() const { return size - Vector(1, 1); }
-
-
-  struct iterator {
+namespace impl {
+  template<typename Field, typename Element>
+  struct FieldIterator {
     using element_type = Element;
     using reference = Element&;
     using pointer = Element*;
     using iterator_category = std::random_access_iterator_tag;
     using difference_type = int;
 
-    iterator() : field(nullptr) {}
-    iterator(FieldT& field, const Vector& pos, const Vector& direction = Vector(0, 0)) : field(&field), pos(pos), direction(direction) {}
+    FieldIterator() : field(nullptr) {}
+    FieldIterator(Field& field, const Vector& pos, const Vector& direction = Vector(0, 0)) : field(&field), pos(pos), direction(direction) {}
 
     // Sentinel type, which can alternatively be used in place of an end() iterator
     struct sentinel {};
 
-    bool operator==(const iterator& other) const { return pos == other.pos; }
-    bool operator!=(const iterator& other) const { return pos != other.pos; }
+    bool operator==(const FieldIterator& other) const { return pos == other.pos; }
+    bool operator!=(const FieldIterator& other) const { return pos != other.pos; }
 
     // We must use negate the condition due to the partial ordering of vectors
     bool operator==(sentinel) const { return !valid(); }
     bool valid() const { return field->validPosition(pos); }
 
-    iterator& operator++() { pos += direction; return *this; }
-    iterator operator++(int) { auto copy = *this; ++(*this); return copy; }
-    iterator& operator-() { pos -= direction; return *this; }
-    iterator operator--(int) { auto copy = *this; --(*this); return copy; }
+    FieldIterator& operator++() { pos += direction; return *this; }
+    FieldIterator operator++(int) { auto copy = *this; ++(*this); return copy; }
+    FieldIterator& operator-() { pos -= direction; return *this; }
+    FieldIterator operator--(int) { auto copy = *this; --(*this); return copy; }
     Element& operator*() const { return (*field)[pos]; }
 
-    iterator& operator+=(int offset) { pos += direction * offset; return *this; }
-    iterator& operator-=(int offset) { pos -= direction * offset; return *this; }
-    iterator operator+(int offset) const { auto copy = *this; copy += offset; return copy; }
-    iterator operator-(int offset) const { auto copy = *this; copy -= offset; return copy; }
+    FieldIterator& operator+=(int offset) { pos += direction * offset; return *this; }
+    FieldIterator& operator-=(int offset) { pos -= direction * offset; return *this; }
+    FieldIterator operator+(int offset) const { auto copy = *this; copy += offset; return copy; }
+    FieldIterator operator-(int offset) const { auto copy = *this; copy -= offset; return copy; }
     
     // Determine the difference between two positions
     // Assumption: other iterator will pass through this position otherwise behavior is undefined
-    difference_type operator-(const iterator& other) const { 
+    difference_type operator-(const FieldIterator& other) const { 
       auto delta = this->pos - other.pos;
       return other.direction.x != 0 ? delta.x / other.direction.x : delta.y / other.direction.y;
     }
@@ -108,49 +77,22 @@ struct FieldT {
     Element& operator[](int index) const { return (*field)[pos + (direction * index)]; }
 
     Vector pos, direction;
-    FieldT* field;
+    Field* field;
   };
 
-  auto rangeFromPositionAndDirection(const Vector& position, const Vector& direction) {
-    iterator begin(*this, position, direction);
-    if (!validPosition(position)) {
-      // starting at invalid position -> return an empty range
-      return std::ranges::subrange(begin, begin);
-    }
-
-    int dx = std::max(direction.x > 0 ? int_div_ceil(size.x - position.x, direction.x) :
-                      direction.x < 0 ? int_div_ceil(-1 - position.x, direction.x) : std::numeric_limits<int>::max(), 0);
-
-    int dy = std::max(direction.y > 0 ? int_div_ceil(size.y - position.y, direction.y) :
-                      direction.y < 0 ? int_div_ceil(-1 - position.y, direction.y) : std::numeric_limits<int>::max(), 0);
-
-    auto distanceToEnd = std::min(dx, dy);
-    return std::ranges::subrange(begin, begin + distanceToEnd);
-  }
 
-  // Return a range representing the i'th row (0-based) left to right
-  auto row(int row) {
-    iterator begin(*this, Vector(0, row), Vector::Right);
-    return std::ranges::subrange(begin, begin + size.x);
-  }
-
-  // Returns a range representing the i'th column (0-based) top to bottom
-  auto column(int column) {
-    iterator begin(*this, Vector(column, 0), Vector::Down);
-    return std::ranges::subrange(begin, begin + size.y);
-  }
-
-  struct rows_columns_iterator {
-    using element_type = std::ranges::subrange<iterator, iterator>;
+  template<typename Field>
+  struct FieldRowsColumnsIterator {
+    using element_type = std::ranges::subrange<typename Field::iterator, typename Field::iterator>;
     using reference = element_type&;
     using pointer = element_type*;
     using iterator_category = std::random_access_iterator_tag;
     using difference_type = int;
-    using self = rows_columns_iterator;
-    using subrange_method = element_type (FieldT::*)(int idx);
+    using self = FieldRowsColumnsIterator;
+    using subrange_method = element_type (Field::*)(int idx);
 
-    rows_columns_iterator() : field(nullptr), idx(0), method(nullptr) {}
-    rows_columns_iterator(FieldT* field, int idx, subrange_method method) : field(field), idx(idx), method(method) {}
+    FieldRowsColumnsIterator() : field(nullptr), idx(0), method(nullptr) {}
+    FieldRowsColumnsIterator(Field* field, int idx, subrange_method method) : field(field), idx(idx), method(method) {}
 
     bool operator==(const self& other) const { return idx == other.idx; } // assumption: no two iterators from different directions will be compared
     bool operator!=(const self& other) const { return idx != other.idx; }
@@ -166,39 +108,435 @@ struct FieldT {
     self operator+(int offset) const { auto copy = *this; copy += offset; return copy; }
     self operator-(int offset) const { auto copy = *this; copy -= offset; return copy; }
 
-    difference_type operator-(const iterator& other) const { return idx - other.idx; }
+    difference_type operator-(const self& other) const { return idx - other.idx; }
     element_type operator[](int index) const { return (field->*method)(idx + index); }
 
-    FieldT* field;
+    Field* field;
     int idx;
     subrange_method method;
   };
 
-  /** Returns an iterator over all rows of this field top to bottom (each row being returned as a range) */
-  auto rows() {
-    return std::ranges::subrange<rows_columns_iterator, rows_columns_iterator> {
-      rows_columns_iterator(this, 0, &FieldT::row),
-      rows_columns_iterator(this, size.y, &FieldT::row),
-    };
+
+  /** Corner positions and row/column ranges shared by FieldT and FieldViewT. 
+   *  The derived Field only needs to provide size, validPosition() and operator[].
+   */
+  template<typename Field, typename Element>
+  struct FieldRanges {
+    using iterator = FieldIterator<Field, Element>;
+    using rows_columns_iterator = FieldRowsColumnsIterator<Field>;
+
+    Vector topLeft() const { return Vector(0, 0); }
+    Vector topRight() const { return Vector(self().size.x - 1, 0); }
+    Vector bottomLeft() const { return Vector(0, self().size.y - 1); }
+    Vector bottomRight() const { return self().size - Vector(1, 1); }
+
+    auto rangeFromPositionAndDirection(const Vector& position, const Vector& direction) {
+      auto& size = self().size;
+      iterator begin(self(), position, direction);
+      if (!self().validPosition(position)) {
+        // starting at invalid position -> return an empty range
+        return std::ranges::subrange(begin, begin);
+      }
+
+      int dx = std::max(direction.x > 0 ? int_div_ceil(size.x - position.x, direction.x) :
+                        direction.x < 0 ? int_div_ceil(-1 - position.x, direction.x) : std::numeric_limits<int>::max(), 0);
+
+      int dy = std::max(direction.y > 0 ? int_div_ceil(size.y - position.y, direction.y) :
+                        direction.y < 0 ? int_div_ceil(-1 - position.y, direction.y) : std::numeric_limits<int>::max(), 0);
+
+      auto distanceToEnd = std::min(dx, dy);
+      return std::ranges::subrange(begin, begin + distanceToEnd);
+    }
+
+    // Return a range representing the i'th row (0-based) left to right
+    std::ranges::subrange<iterator, iterator> row(int row) {
+      iterator begin(self(), Vector(0, row), Vector::Right);
+      return std::ranges::subrange(begin, begin + self().size.x);
+    }
+
+    // Returns a range representing the i'th column (0-based) top to bottom
+    std::ranges::subrange<iterator, iterator> column(int column) {
+      iterator begin(self(), Vector(column, 0), Vector::Down);
+      return std::ranges::subrange(begin, begin + self().size.y);
+    }
+
+    /** Returns an iterator over all rows of this field top to bottom (each row being returned as a range) */
+    auto rows() {
+      return std::ranges::subrange<rows_columns_iterator, rows_columns_iterator> {
+        rows_columns_iterator(&self(), 0, &Field::row),
+        rows_columns_iterator(&self(), self().size.y, &Field::row),
+      };
+    }
+
+    /** Returns an iterator over all columns of this field left to right (each row being returned as a range) */
+    auto columns() {
+      return std::ranges::subrange<rows_columns_iterator, rows_columns_iterator> {
+        rows_columns_iterator(&self(), 0, &Field::column),
+        rows_columns_iterator(&self(), self().size.x, &Field::column),
+      };
+    }
+
+  private:
+    Field& self() { return static_cast<Field&>(*this); }
+    const Field& self() const { return static_cast<const Field&>(*this); }
+  };
+}
+
+
+/** Storage layouts for FieldT, which map the (padded) positions [0, size) to offsets in FieldT::data.
+ *  Besides toOffset()/fromOffset() each layout enumerates the cells of a rectangle as runs of consecutive offsets
+ *  in row major order, which lets whole field scans work on contiguous memory.
+ */
+namespace layout {
+  /** Plain rows one after another (the default) */
+  struct RowMajor {
+    RowMajor(Vector size = Vector(0, 0)) : stride(size.x), height(size.y) {}
+
+    size_t cells() const { return static_cast<size_t>(stride) * height; }
+    int toOffset(const Vector& pos) const { return pos.y * stride + pos.x; }
+    Vector fromOffset(size_t offset) const { return Vector(static_cast<int>(offset) % stride, static_cast<int>(offset) / stride); }
+
+    template<typename Fn>
+    void forEachRun(const Vector& begin, const Vector& size, Fn&& fn) const {
+      if (begin.x == 0 && size.x == stride) {
+        fn(static_cast<size_t>(toOffset(begin)), static_cast<size_t>(size.x) * size.y); // the rows are adjacent
+        return;
+      }
+      for (int y = begin.y; y < begin.y + size.y; ++y) {
+        fn(static_cast<size_t>(toOffset(Vector(begin.x, y))), static_cast<size_t>(size.x));
+      }
+    }
+
+    int stride; // distance between the offsets of two rows
+    int height;
+  };
+
+
+  /** Square tiles of TileSize x TileSize cells stored row major, while the tiles themselves are stored row major.
+   *  Vertical neighbours are within the same tile most of the time, which keeps column walks and 2D stencils in cache.
+   */
+  template<int TileSize = 16>
+  struct Tiled {
+    static_assert(TileSize > 0 && (TileSize & (TileSize - 1)) == 0, "TileSize must be a power of two");
+    static constexpr int TileCells = TileSize * TileSize;
+
+    Tiled(Vector size = Vector(0, 0)) : tilesX((size.x + TileSize - 1) / TileSize), tilesY((size.y + TileSize - 1) / TileSize) {}
+
+    size_t cells() const { return static_cast<size_t>(tilesX) * tilesY * TileCells; }
+    int toOffset(const Vector& pos) const {
+      unsigned x = pos.x, y = pos.y; // unsigned to turn the divisions into shifts
+      return static_cast<int>(((y / TileSize) * tilesX + x / TileSize) * TileCells + (y % TileSize) * TileSize + x % TileSize);
+    }
+    Vector fromOffset(size_t offset) const {
+      int tile = static_cast<int>(offset / TileCells), cell = static_cast<int>(offset % TileCells);
+      return Vector((tile % tilesX) * TileSize + cell % TileSize, (tile / tilesX) * TileSize + cell / TileSize);
+    }
+
+    template<typename Fn>
+    void forEachRun(const Vector& begin, const Vector& size, Fn&& fn) const {
+      for (int y = begin.y; y < begin.y + size.y; ++y) {
+        for (int x = begin.x; x < begin.x + size.x; ) {
+          int length = std::min(TileSize - x % TileSize, begin.x + size.x - x); // until the end of the tile row
+          fn(static_cast<size_t>(toOffset(Vector(x, y))), static_cast<size_t>(length));
+          x += length;
+        }
+      }
+    }
+
+    int tilesX, tilesY;
+  };
+
+
+  /** Z-order (Morton) curve, which interleaves the bits of x and y, so cells close in both directions are close in memory.
+   *  Both sides are rounded up to powers of two and the surplus bits of the longer side are stored above the interleaved ones.
+   */
+  struct Morton {
+    Morton(Vector size = Vector(0, 0)) : bitsX(bitsFor(size.x)), bitsY(bitsFor(size.y)), commonBits(std::min(bitsX, bitsY)) {}
+
+    size_t cells() const { return size_t(1) << (bitsX + bitsY); }
+    int toOffset(const Vector& pos) const {
+      uint32_t x = pos.x, y = pos.y;
+      uint32_t mask = (uint32_t(1) << commonBits) - 1;
+      return static_cast<int>(spread(x & mask) | (spread(y & mask) << 1) | (((x | y) >> commonBits) << (2 * commonBits)));
+    }
+    Vector fromOffset(size_t offset) const {
+      uint32_t low = static_cast<uint32_t>(offset & ((uint64_t(1) << (2 * commonBits)) - 1));
+      uint32_t high = static_cast<uint32_t>(offset >> (2 * commonBits));
+      uint32_t x = compact(low), y = compact(low >> 1);
+      (bitsX > bitsY ? x : y) |= high << commonBits;
+      return Vector(static_cast<int>(x), static_cast<int>(y));
+    }
+
+    template<typename Fn>
+    void forEachRun(const Vector& begin, const Vector& size, Fn&& fn) const {
+      for (int y = begin.y; y < begin.y + size.y; ++y) {
+        for (int x = begin.x; x < begin.x + size.x; ++x) {
+          fn(static_cast<size_t>(toOffset(Vector(x, y))), size_t(1));
+        }
+      }
+    }
+
+    int bitsX, bitsY, commonBits;
+
+  private:
+    static int bitsFor(int length) { return length > 1 ? std::bit_width(static_cast<uint32_t>(length - 1)) : 0; }
+
+    /** Moves bit i of value to bit 2i */
+    static uint64_t spread(uint32_t value) {
+      uint64_t bits = value;
+      bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFull;
+      bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFull;
+      bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+      bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+      bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+      return bits;
+    }
+
+    /** Inverse of spread() for the even bits of value */
+    static uint32_t compact(uint64_t bits) {
+      bits &= 0x5555555555555555ull;
+      bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+      bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+      bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFull;
+      bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFull;
+      bits = (bits | (bits >> 16)) & 0x00000000FFFFFFFFull;
+      return static_cast<uint32_t>(bits);
+    }
+  };
+}
+
+
+/** Two dimensional field of elements. The Layout determines the order of the cells in data (layout::RowMajor, layout::Tiled<>
+ *  or layout::Morton), so code working on data directly must map positions through toOffset()/fromOffset().
+ */
+template<typename Element, typename Layout = layout::RowMajor>
+struct FieldT : impl::FieldRanges<FieldT<Element, Layout>, Element> {
+  FieldT(int width, int height, Element fill) : size(width, height), layout(size) {
+    data.resize(layout.cells(), fill);
+  }
+
+  /** Creates a copy of field, which is surrounded by padding cells of the sentinel value on each side.
+   *  Positions stay the same, but neighbour probes up to padding cells outside of the field stay within data and
+   *  return the sentinel, so hot loops can replace the validPosition() check with a check for the sentinel value
+   *  (e.g. a '#' border for PathFinderT). Offsets refer to the padded data, so use toOffset()/fromOffset() instead of
+   *  assuming width * y + x. The source field may use a different layout.
+   */
+  template<typename OtherLayout>
+  FieldT(const FieldT<Element, OtherLayout>& field, int padding, Element sentinel) : size(field.size), padding(padding), layout(field.size + Vector(2 * padding, 2 * padding)) {
+    if constexpr (std::is_same_v<Layout, layout::RowMajor>) {
+      origin = layout.toOffset(Vector(padding, padding));
+    }
+    data.assign(layout.cells(), sentinel);
+    for (int y = 0; y < size.y; ++y) {
+      for (int x = 0; x < size.x; ++x) {
+        (*this)[Vector(x, y)] = field[Vector(x, y)];
+      }
+    }
+  }
+
+  /** Converts a field from another layout */
+  template<typename OtherLayout> requires (!std::is_same_v<Layout, OtherLayout>)
+  explicit FieldT(const FieldT<Element, OtherLayout>& field) : FieldT(field, 0, Element{}) {}
+
+  FieldT(std::istream&& source) : FieldT(source) {}
+  FieldT(std::istream& source) : size(0, 0) {
+    std::vector<Element> rows;
+    for (std::string line; std::getline(source, line);) {
+      if (line.empty()) { // special case for Day 15 where the field is followed by a newline and instructions
+        break;
+      }
+      rows.insert(rows.end(), line.begin(), line.end()); // Element must be constructible from a single char
+      size.x = static_cast<int>(line.length());
+      ++size.y;
+    }
+
+    layout = Layout(size);
+    if constexpr (std::is_same_v<Layout, layout::RowMajor>) {
+      data = std::move(rows);
+    } else {
+      data.assign(layout.cells(), Element(' '));
+      for (size_t offset = 0; offset < rows.size(); ++offset) {
+        data[toOffset(Vector(static_cast<int>(offset) % size.x, static_cast<int>(offset) / size.x))] = rows[offset];
+      }
+    }
+  }
+
+  /** Resizes the field to the given size (without padding) with all cells set to fill, while reusing the allocated storage */
+  void assign(const Vector& newSize, Element fill) {
+    size = newSize;
+    padding = 0;
+    origin = 0;
+    layout = Layout(size);
+    data.assign(layout.cells(), fill);
   }
 
-  /** Returns an iterator over all columns of this field left to right (each row being returned as a range) */
-  auto columns() {
-    return std::ranges::subrange<rows_columns_iterator, rows_columns_iterator> {
-      rows_columns_iterator(this, 0, &FieldT::column),
-      rows_columns_iterator(this, size.x, &FieldT::column),
-    };
+  template<typename Self>
+  auto& operator[](this Self&& self, const Vector& pos) { return self.data[self.toOffset(pos)]; }
+  bool validPosition(const Vector& pos) const { return pos.x >= 0 && pos.y >= 0 && pos.x < size.x && pos.y < size.y; }
+  bool isAt(const Element& element, const Vector& pos) const { return validPosition(pos) && (*this)[pos] == element; }
+  /** checked field access, which returns a copy to the field value if the position is valid */
+  std::optional<Element> at(const Vector& pos) const { return validPosition(pos) ? std::optional<Element>(data[toOffset(pos)]) : std::nullopt; }
+  Element at(const Vector& pos, Element defaultValue) const { return validPosition(pos) ? data[toOffset(pos)] : defaultValue; }
+
+  /** Row major offsets are linear in the position, so the padding is folded into the offset of position (0, 0) and an
+   *  unpadded field maps positions like a plain row major array. Its fromOffset() maps the padding cells to some position
+   *  outside of the field, which is not necessarily the sentinel's own position.
+   */
+  int toOffset(const Vector& pos) const {
+    if constexpr (std::is_same_v<Layout, layout::RowMajor>) {
+      return origin + layout.toOffset(pos);
+    } else {
+      return layout.toOffset(pos + Vector(padding, padding));
+    }
+  }
+  Vector fromOffset(size_t offset) const {
+    if constexpr (std::is_same_v<Layout, layout::RowMajor>) {
+      int cell = static_cast<int>(offset) - origin;
+      return Vector(cell % layout.stride, cell / layout.stride);
+    } else {
+      return layout.fromOffset(offset) - Vector(padding, padding);
+    }
+  }
+  size_t findOffset(const Element& element, size_t startOffset = 0) const {
+    bool dense = padding == 0 && std::is_same_v<Layout, layout::RowMajor>; // all offsets are cells of the field
+    for (auto pos = std::find(data.begin() + startOffset, data.end(), element); pos != data.end(); pos = std::find(pos + 1, data.end(), element)) {
+      if (dense || validPosition(fromOffset(std::distance(data.begin(), pos)))) { // skip sentinels and unused cells
+        return std::distance(data.begin(), pos);
+      }
+    }
+    return std::numeric_limits<size_t>::max();
+  }
+
+  /** True if the field is surrounded by sentinel cells (see FieldT(field, padding, sentinel)) */
+  bool isPadded() const { return padding > 0; }
+  /** The value of the padding cells of a padded field */
+  const Element& sentinel() const { return data.front(); }
+
+  /** Offset deltas of the 4 (or 8) neighbours of a cell for forEachNeighbour(offset, deltas, fn) (row major layout only).
+   *  Neighbour offsets of the border cells are only valid in a padded field.
+   */
+  template<int Count = 4>
+  std::array<int, Count> neighbourDeltas() const requires std::is_same_v<Layout, layout::RowMajor> { return ::neighbourDeltas<Count>(layout.stride); }
+
+  /** Returns the number of cells equal to element (vectorized for small integral elements) */
+  size_t count(const Element& element) const {
+    size_t result = 0;
+    forEachRun([&](std::span<const Element> cells, size_t) { result += scan::count(cells, element); });
+    return result;
+  }
+
+  /** Returns the offsets of all cells equal to element in the row major order of their positions */
+  std::vector<size_t> findAll(const Element& element) const {
+    std::vector<size_t> offsets;
+    forEachRun([&](std::span<const Element> cells, size_t base) {
+      scan::forEachMatch(cells, element, [&](size_t offset) { offsets.push_back(base + offset); });
+    });
+    return offsets;
+  }
+
+  /** Returns the positions of all cells equal to element in row major order */
+  std::vector<Vector> positionsOf(const Element& element) const {
+    std::vector<Vector> positions;
+    forEachRun([&](std::span<const Element> cells, size_t base) {
+      scan::forEachMatch(cells, element, [&](size_t offset) { positions.push_back(fromOffset(base + offset)); });
+    });
+    return positions;
+  }
+
+  /** Collects the positions of all given elements in a single pass over the field,
+   *  where result[i] contains the positions of elements[i] in row major order (e.g. classify({'#', 'S', 'E'}))
+   */
+  std::vector<std::vector<Vector>> classify(std::initializer_list<Element> elements) const {
+    std::vector<std::vector<Vector>> positions(elements.size());
+    forEachRun([&](std::span<const Element> cells, size_t base) {
+      scan::forEachMatch(cells, std::span<const Element>(elements.begin(), elements.size()), [&](size_t offset, size_t index) {
+        positions[index].push_back(fromOffset(base + offset));
+      });
+    });
+    return positions;
   }
 
   Vector size;
+  int padding = 0; // number of sentinel cells around each side of the field
+  int origin = 0; // offset of position (0, 0) in a row major layout
+  Layout layout; // maps the padded positions to offsets
   std::vector<Element> data;
+
+private:
+  /** Calls fn(cells, baseOffset) for the contiguous runs of field cells (without padding or unused cells) in row major order */
+  template<typename Fn>
+  void forEachRun(Fn&& fn) const {
+    layout.forEachRun(Vector(padding, padding), size, [&](size_t base, size_t length) {
+      fn(std::span<const Element>(data.data() + base, length), base);
+    });
+  }
 };
 
 using Field = FieldT<char>;
 
 
+/** A field, which wraps an existing input buffer (e.g. the result of task::inputString()) in place without copying.
+ *  The rows are addressed with a stride, which includes the line break ("\n" or "\r\n"). As with FieldT(std::istream&)
+ *  the field ends at the first empty line or the end of the buffer. The buffer must outlive the view.
+ *  Use FieldViewT<char> over a mutable buffer to modify the cells in place.
+ */
 template<typename Element>
-std::ostream& operator<<(std::ostream& out, FieldT<Element>& field) {
+struct FieldViewT : impl::FieldRanges<FieldViewT<Element>, Element> {
+  FieldViewT(std::span<Element> buffer) : size(0, 0), data(buffer.data()), stride(0) {
+    auto lineEnd = std::find(buffer.begin(), buffer.end(), '\n');
+    size.x = static_cast<int>(std::distance(buffer.begin(), lineEnd));
+    stride = size.x + (lineEnd != buffer.end() ? 1 : 0);
+    if (size.x > 0 && buffer[size.x - 1] == '\r') {
+      --size.x;
+    }
+
+    for (size_t offset = 0; offset + size.x <= buffer.size() && size.x > 0 && buffer[offset] != '\r' && buffer[offset] != '\n'; offset += stride) {
+      ++size.y;
+    }
+  }
+
+  Element& operator[](const Vector& pos) const { return data[toOffset(pos)]; }
+  bool validPosition(const Vector& pos) const { return pos.x >= 0 && pos.y >= 0 && pos.x < size.x && pos.y < size.y; }
+  bool isAt(const Element& element, const Vector& pos) const { return validPosition(pos) && (*this)[pos] == element; }
+  /** checked field access, which returns a copy to the field value if the position is valid */
+  std::optional<std::remove_const_t<Element>> at(const Vector& pos) const { return validPosition(pos) ? std::optional<std::remove_const_t<Element>>(data[toOffset(pos)]) : std::nullopt; }
+  std::remove_const_t<Element> at(const Vector& pos, std::remove_const_t<Element> defaultValue) const { return validPosition(pos) ? data[toOffset(pos)] : defaultValue; }
+
+  /** The offsets include the line breaks and are thus only compatible with toOffset()/fromOffset() of the same view */
+  int toOffset(const Vector& pos) const { return pos.y * stride + pos.x; }
+  Vector fromOffset(size_t offset) const { return Vector(static_cast<int>(offset) % stride, static_cast<int>(offset) / stride); }
+  /** Offset deltas of the 4 (or 8) neighbours of a cell for forEachNeighbour(offset, deltas, fn) */
+  template<int Count = 4>
+  std::array<int, Count> neighbourDeltas() const { return ::neighbourDeltas<Count>(stride); }
+  size_t findOffset(const Element& element, size_t startOffset = 0) const {
+    auto end = size.y > 0 ? data + toOffset(this->bottomRight()) + 1 : data; // the last row may lack a line break
+    for (auto pos = std::find(data + startOffset, end, element); pos != end; pos = std::find(pos + 1, end, element)) {
+      if ((pos - data) % stride < size.x) { // skip matches in the line breaks
+        return pos - data;
+      }
+    }
+    return std::numeric_limits<size_t>::max();
+  }
+
+  /** Copies the viewed cells into a FieldT */
+  FieldT<std::remove_const_t<Element>> toField() const {
+    FieldT<std::remove_const_t<Element>> field(size.x, size.y, {});
+    for (int y = 0; y < size.y; ++y) {
+      std::copy(data + toOffset(Vector(0, y)), data + toOffset(Vector(size.x, y)), field.data.begin() + field.toOffset(Vector(0, y)));
+    }
+    return field;
+  }
+
+  Vector size;
+  Element* data;
+  int stride; // distance between the start of two rows
+};
+
+using FieldView = FieldViewT<const char>;
+
+
+template<typename Element, typename Layout>
+std::ostream& operator<<(std::ostream& out, FieldT<Element, Layout>& field) {
   for (int y = 0; y < field.size.y; ++y) {
     for (int x = 0; x < field.size.x; ++x) {
       out << field[Vector(x, y)];
@@ -206,4 +544,14 @@ std::ostream& operator<<(std::ostream& out, FieldT<Element>& field) {
     out << "\n";
   }
   return out;
-}
\ No newline at end of file
+}
+
+
+template<typename Element>
+std::ostream& operator<<(std::ostream& out, const FieldViewT<Element>& field) {
+  for (int y = 0; y < field.size.y; ++y) {
+    out.write(&field[Vector(0, y)], field.size.x);
+    out << "\n";
+  }
+  return out;
+}
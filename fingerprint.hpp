@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "field.hpp"
+
+namespace fingerprint {
+  /** Finalizer of splitmix64, which spreads each input bit over the whole result */
+  inline uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+  }
+
+  /** Hash of a single cell at the given offset, which is summed up for the fingerprint of a TrackedFieldT */
+  template<typename T>
+  uint64_t cell(size_t offset, const T& value) {
+    return mix(offset * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(std::hash<T>{}(value)));
+  }
+}
+
+
+/** Returns a 64 bit hash over the raw bytes of field.data, which is meant for detecting repeated states of a simulation.
+ *  Four independent lanes of 8 byte words are hashed in parallel to keep the multiplier busy.
+ *  Different fields may collide, so compare the fields themselves if a false positive would be fatal.
+ */
+template<typename T, typename Layout>
+uint64_t fingerprintOf(const FieldT<T, Layout>& field) {
+  static_assert(std::is_trivially_copyable_v<T>, "the fingerprint hashes the bytes of the cells");
+  auto bytes = reinterpret_cast<const unsigned char*>(field.data.data());
+  size_t length = field.data.size() * sizeof(T);
+
+  constexpr uint64_t Multiplier = 0x9E3779B97F4A7C15ull;
+  uint64_t lanes[4] = { 1, 2, 3, 4 };
+  size_t offset = 0;
+  for (; offset + 32 <= length; offset += 32) {
+    for (int lane = 0; lane < 4; ++lane) {
+      uint64_t word;
+      std::memcpy(&word, bytes + offset + lane * 8, 8);
+      lanes[lane] = (lanes[lane] ^ word) * Multiplier;
+      lanes[lane] ^= lanes[lane] >> 29;
+    }
+  }
+
+  uint64_t hash = fingerprint::mix(length);
+  for (; offset < length; offset += 8) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes + offset, std::min<size_t>(length - offset, 8));
+    hash = fingerprint::mix(hash ^ word);
+  }
+  for (auto lane : lanes) {
+    hash = fingerprint::mix(hash ^ lane);
+  }
+  return hash ^ fingerprint::mix(static_cast<uint64_t>(field.size.x) << 32 | static_cast<uint32_t>(field.size.y));
+}
+
+
+/** Field wrapper, which maintains a Zobrist style fingerprint (the sum of fingerprint::cell() over all cells) while it is modified.
+ *  All writes must go through set(), which updates the fingerprint in O(1), so a simulation can check for repeated states
+ *  after each step without rehashing the whole field.
+ */
+template<typename T>
+struct TrackedFieldT {
+  TrackedFieldT(FieldT<T> field) : cells(std::move(field)) { recompute(); }
+
+  const T& operator[](const Vector& pos) const { return cells[pos]; }
+  bool validPosition(const Vector& pos) const { return cells.validPosition(pos); }
+  T at(const Vector& pos, T defaultValue) const { return cells.at(pos, defaultValue); }
+
+  void set(const Vector& pos, const T& value) {
+    int offset = cells.toOffset(pos);
+    hash += fingerprint::cell(offset, value) - fingerprint::cell(offset, cells.data[offset]);
+    cells.data[offset] = value;
+  }
+
+  /** Swaps the values of two cells (e.g. moving a rock) */
+  void swap(const Vector& a, const Vector& b) {
+    T value = cells[a];
+    set(a, cells[b]);
+    set(b, value);
+  }
+
+  uint64_t fingerprint() const { return hash; }
+  const FieldT<T>& field() const { return cells; }
+  const Vector& size() const { return cells.size; }
+
+  /** Recalculates the fingerprint from scratch */
+  void recompute() {
+    hash = 0;
+    for (size_t offset = 0; offset < cells.data.size(); ++offset) {
+      hash += fingerprint::cell(offset, cells.data[offset]);
+    }
+  }
+
+private:
+  FieldT<T> cells;
+  uint64_t hash = 0;
+};
+
+using TrackedField = TrackedFieldT<char>;
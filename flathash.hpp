@@ -0,0 +1,369 @@
+#pragma once
+
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+#include "hash.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLATHASH_SIMD 1
+#else
+#define FLATHASH_SIMD 0
+#endif
+
+// Only declared, so that this header works with vector.hpp as well as with vector3d.hpp
+template<typename T>
+struct VectorT;
+template<typename T>
+struct VectorT3D;
+
+/** Packs both (32 bit) coordinates of a 2D vector losslessly into a single 64 bit key */
+template<typename T>
+uint64_t packKey(const VectorT<T>& vec) { return static_cast<uint64_t>(static_cast<uint32_t>(vec.x)) << 32 | static_cast<uint32_t>(vec.y); }
+
+template<typename T = int>
+VectorT<T> unpackKey(uint64_t key) { return VectorT<T>(static_cast<int32_t>(key >> 32), static_cast<int32_t>(key)); }
+
+
+namespace impl {
+  /** Finalizer of murmur3/splitmix64, so that neighbouring coordinates end up in unrelated groups */
+  inline uint64_t mixKey(uint64_t key) {
+    key = (key ^ (key >> 33)) * 0xFF51AFD7ED558CCDull;
+    key = (key ^ (key >> 33)) * 0xC4CEB9FE1A85EC53ull;
+    return key ^ (key >> 33);
+  }
+}
+
+/** Default hash of the flat hash containers, which must spread its result over all 64 bits, because the low bits select the
+ *  group and the high bits are stored in the control bytes. Integers and vectors are mixed directly, other types use hashing::hashOf().
+ */
+template<typename Key>
+struct FlatHash {
+  uint64_t operator()(const Key& key) const {
+    if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key>) {
+      return impl::mixKey(static_cast<uint64_t>(key));
+    } else {
+      return hashing::hashOf(key);
+    }
+  }
+};
+
+template<typename T>
+struct FlatHash<VectorT<T>> {
+  uint64_t operator()(const VectorT<T>& vec) const { return impl::mixKey(packKey(vec)); }
+};
+
+template<typename T>
+struct FlatHash<VectorT3D<T>> {
+  uint64_t operator()(const VectorT3D<T>& vec) const {
+    uint64_t xy = static_cast<uint64_t>(static_cast<uint32_t>(vec.x)) << 32 | static_cast<uint32_t>(vec.y);
+    return impl::mixKey(xy ^ impl::mixKey(static_cast<uint64_t>(vec.z)));
+  }
+};
+
+
+namespace impl {
+  /** Control bytes of the slots. Full slots store the low 7 bits of their key's hash (0..127). */
+  constexpr int8_t EmptySlot = -128;
+  constexpr int8_t DeletedSlot = -2;
+  constexpr size_t GroupSize = 16;
+
+  /** Bit mask of the slots within a group of 16 control bytes, whose byte equals the given one */
+  inline uint32_t matchGroup(const int8_t* group, int8_t control) {
+#if FLATHASH_SIMD
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(control))));
+#else
+    uint32_t mask = 0;
+    for (size_t slot = 0; slot < GroupSize; ++slot) {
+      mask |= static_cast<uint32_t>(group[slot] == control) << slot;
+    }
+    return mask;
+#endif
+  }
+
+  /** Bit mask of the empty or deleted slots within a group (both have the sign bit set) */
+  inline uint32_t matchFree(const int8_t* group) {
+#if FLATHASH_SIMD
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+    uint32_t mask = 0;
+    for (size_t slot = 0; slot < GroupSize; ++slot) {
+      mask |= static_cast<uint32_t>(group[slot] < 0) << slot;
+    }
+    return mask;
+#endif
+  }
+
+
+  /** Open addressing hash table in the style of SwissTable, which stores its slots in one flat array.
+   *  The slots are split into groups of 16, whose control bytes are compared against the key's 7 bit tag with a single
+   *  SSE2 instruction, so a lookup usually touches one group and compares only the keys with a matching tag.
+   *  Groups are probed quadratically and the table grows at a load factor of 7/8.
+   */
+  template<typename Key, typename Slot, typename Hash, typename KeyOf>
+  struct FlatHashTable {
+    template<bool Const>
+    struct Iterator {
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Slot;
+      using difference_type = std::ptrdiff_t;
+      using pointer = std::conditional_t<Const, const Slot*, Slot*>;
+      using reference = std::conditional_t<Const, const Slot&, Slot&>;
+      using Table = std::conditional_t<Const, const FlatHashTable, FlatHashTable>;
+
+      Iterator(Table* table = nullptr, size_t index = 0) : table(table), index(index) { skipFree(); }
+      operator Iterator<true>() const requires (!Const) { return Iterator<true>(table, index); }
+
+      reference operator*() const { return table->slots[index]; }
+      pointer operator->() const { return &table->slots[index]; }
+
+      Iterator& operator++() {
+        ++index;
+        skipFree();
+        return *this;
+      }
+      Iterator operator++(int) {
+        auto result = *this;
+        ++*this;
+        return result;
+      }
+
+      bool operator==(const Iterator& other) const { return index == other.index; }
+      bool operator!=(const Iterator& other) const { return index != other.index; }
+
+    private:
+      void skipFree() {
+        while (table && index < table->control.size() && table->control[index] < 0) {
+          ++index;
+        }
+      }
+
+      Table* table;
+      size_t index;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashTable() = default;
+    FlatHashTable(const FlatHashTable&) = default;
+    FlatHashTable& operator=(const FlatHashTable&) = default;
+
+    // The vectors of a moved from table are empty, so its counters must be reset as well
+    FlatHashTable(FlatHashTable&& other) noexcept : control(std::move(other.control)), slots(std::move(other.slots)),
+                                                    entries(std::exchange(other.entries, 0)), tombstones(std::exchange(other.tombstones, 0)) {}
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+      if (this != &other) {
+        control = std::move(other.control);
+        slots = std::move(other.slots);
+        entries = std::exchange(other.entries, 0);
+        tombstones = std::exchange(other.tombstones, 0);
+        other.control.clear();
+        other.slots.clear();
+      }
+      return *this;
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, control.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, control.size()); }
+
+    iterator find(const Key& key) { return iterator(this, findIndex(key)); }
+    const_iterator find(const Key& key) const { return const_iterator(this, findIndex(key)); }
+    bool contains(const Key& key) const { return findIndex(key) != control.size(); }
+    size_t count(const Key& key) const { return contains(key); }
+
+    /** Returns 1 if the key was removed and 0 if it wasn't present */
+    size_t erase(const Key& key) {
+      size_t index = findIndex(key);
+      if (index == control.size()) {
+        return 0;
+      }
+      slots[index] = Slot{}; // new entries expect a default constructed slot
+      // A group, which still has an empty slot, has never been probed past, so the slot may become empty again
+      const int8_t* group = &control[index & ~(GroupSize - 1)];
+      if (matchGroup(group, EmptySlot)) {
+        control[index] = EmptySlot;
+      } else {
+        control[index] = DeletedSlot;
+        ++tombstones;
+      }
+      --entries;
+      return 1;
+    }
+
+    size_t size() const { return entries; }
+    bool empty() const { return entries == 0; }
+    size_t capacity() const { return control.size(); }
+
+    /** Removes all entries, but keeps the allocated slots */
+    void clear() {
+      std::fill(control.begin(), control.end(), EmptySlot);
+      std::fill(slots.begin(), slots.end(), Slot{});
+      entries = 0;
+      tombstones = 0;
+    }
+
+    /** Makes room for count entries without rehashing */
+    void reserve(size_t count) {
+      if (count > maxLoad(control.size())) {
+        rehash(capacityFor(count));
+      }
+    }
+
+  protected:
+    /** Returns the slot index of the key or capacity() if it isn't present */
+    size_t findIndex(const Key& key) const {
+      if (entries == 0) {
+        return control.size();
+      }
+      uint64_t hash = Hash{}(key);
+      int8_t tag = static_cast<int8_t>(hash & 0x7F);
+      size_t groupMask = control.size() / GroupSize - 1;
+      size_t group = (hash >> 7) & groupMask;
+      for (size_t step = 1;; ++step) {
+        const int8_t* groupControl = &control[group * GroupSize];
+        for (uint32_t mask = matchGroup(groupControl, tag); mask; mask &= mask - 1) {
+          size_t index = group * GroupSize + std::countr_zero(mask);
+          if (KeyOf{}(slots[index]) == key) {
+            return index;
+          }
+        }
+        if (matchGroup(groupControl, EmptySlot)) {
+          return control.size();
+        }
+        group = (group + step) & groupMask; // triangular numbers visit each group once
+      }
+    }
+
+    /** Returns the slot index of the key and whether it was newly inserted. A new slot only has its key set. */
+    std::pair<size_t, bool> insertIndex(const Key& key) {
+      size_t index = findIndex(key);
+      if (index != control.size()) {
+        return { index, false };
+      }
+      if (entries + tombstones + 1 > maxLoad(control.size())) {
+        // Rehashing at the same capacity is enough if most of the load consists of erased slots
+        rehash(entries + 1 > maxLoad(control.size()) / 2 ? capacityFor(entries + 1) : control.size());
+      }
+      uint64_t hash = Hash{}(key);
+      index = freeIndex(hash);
+      tombstones -= control[index] == DeletedSlot;
+      control[index] = static_cast<int8_t>(hash & 0x7F);
+      KeyOf{}(slots[index]) = key;
+      ++entries;
+      return { index, true };
+    }
+
+    std::vector<int8_t> control;
+    std::vector<Slot> slots;
+
+  private:
+    static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+    static size_t capacityFor(size_t count) {
+      size_t capacity = GroupSize;
+      while (maxLoad(capacity) < count) {
+        capacity *= 2;
+      }
+      return capacity;
+    }
+
+    /** First empty or deleted slot along the probe sequence of the hash (there always is one) */
+    size_t freeIndex(uint64_t hash) const {
+      size_t groupMask = control.size() / GroupSize - 1;
+      size_t group = (hash >> 7) & groupMask;
+      for (size_t step = 1;; ++step) {
+        if (uint32_t mask = matchFree(&control[group * GroupSize])) {
+          return group * GroupSize + std::countr_zero(mask);
+        }
+        group = (group + step) & groupMask;
+      }
+    }
+
+    void rehash(size_t capacity) {
+      auto oldControl = std::move(control);
+      auto oldSlots = std::move(slots);
+      control.assign(capacity, EmptySlot);
+      slots.assign(capacity, Slot{});
+      tombstones = 0;
+      for (size_t index = 0; index < oldControl.size(); ++index) {
+        if (oldControl[index] >= 0) {
+          uint64_t hash = Hash{}(KeyOf{}(oldSlots[index]));
+          size_t target = freeIndex(hash);
+          control[target] = static_cast<int8_t>(hash & 0x7F);
+          slots[target] = std::move(oldSlots[index]);
+        }
+      }
+    }
+
+    size_t entries = 0;
+    size_t tombstones = 0;
+  };
+
+  struct PairKey {
+    template<typename Pair>
+    auto& operator()(Pair& pair) const { return pair.first; }
+  };
+
+  struct SelfKey {
+    template<typename Key>
+    Key& operator()(Key& key) const { return key; }
+  };
+}
+
+
+/** Flat hash map with an interface similar to std::unordered_map for small, cheaply copyable keys (e.g. Vector or packed states).
+ *  Key and Value must be default constructible. Iterators and references are invalidated by every insertion, which grows the table.
+ *  The entries are std::pair<Key, Value>, whose key must not be modified through an iterator.
+ */
+template<typename Key, typename Value, typename Hash = FlatHash<Key>>
+struct FlatHashMap : impl::FlatHashTable<Key, std::pair<Key, Value>, Hash, impl::PairKey> {
+  using value_type = std::pair<Key, Value>;
+  using iterator = typename impl::FlatHashTable<Key, value_type, Hash, impl::PairKey>::iterator;
+
+  Value& operator[](const Key& key) { return this->slots[this->insertIndex(key).first].second; }
+
+  /** Inserts the value if the key isn't present yet and returns the entry of the key and whether it was inserted */
+  std::pair<iterator, bool> emplace(const Key& key, Value value) {
+    auto [index, inserted] = this->insertIndex(key);
+    if (inserted) {
+      this->slots[index].second = std::move(value);
+    }
+    return { iterator(this, index), inserted };
+  }
+  std::pair<iterator, bool> insert(const value_type& entry) { return emplace(entry.first, entry.second); }
+
+  /** Returns a pointer to the key's value or nullptr if it isn't present */
+  Value* get(const Key& key) {
+    size_t index = this->findIndex(key);
+    return index != this->control.size() ? &this->slots[index].second : nullptr;
+  }
+  const Value* get(const Key& key) const {
+    size_t index = this->findIndex(key);
+    return index != this->control.size() ? &this->slots[index].second : nullptr;
+  }
+};
+
+
+/** Flat hash set counterpart of FlatHashMap */
+template<typename Key, typename Hash = FlatHash<Key>>
+struct FlatHashSet : impl::FlatHashTable<Key, Key, Hash, impl::SelfKey> {
+  using value_type = Key;
+  using const_iterator = typename impl::FlatHashTable<Key, Key, Hash, impl::SelfKey>::const_iterator;
+
+  /** Returns the entry of the key and whether it was inserted */
+  std::pair<const_iterator, bool> insert(const Key& key) {
+    auto [index, inserted] = this->insertIndex(key);
+    return { const_iterator(this, index), inserted };
+  }
+  std::pair<const_iterator, bool> emplace(const Key& key) { return insert(key); }
+};
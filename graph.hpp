@@ -0,0 +1,172 @@
+#pragma once
+
+#include <span>
+#include <tuple>
+#include <vector>
+#include <ranges>
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+
+#include "field.hpp"
+#include "search.hpp"
+
+/** Weighted directed graph stored in compressed sparse row layout: the outgoing edges of a node are stored
+ *  contiguously in edges[offsets[node]] ... edges[offsets[node + 1] - 1].
+ */
+struct Graph {
+  struct Edge {
+    int target, weight;
+  };
+
+  Graph() = default;
+
+  /** Builds the graph from an unordered list of (from, to, weight) edges
+   */
+  Graph(int nodeCount, std::span<const std::tuple<int, int, int>> edgeList) : offsets(nodeCount + 1, 0) {
+    for (auto& [from, to, weight] : edgeList) {
+      ++offsets[from + 1];
+    }
+    for (int node = 0; node < nodeCount; ++node) {
+      offsets[node + 1] += offsets[node];
+    }
+    edges.resize(edgeList.size());
+    auto insertPos = offsets;
+    for (auto& [from, to, weight] : edgeList) {
+      edges[insertPos[from]++] = { to, weight };
+      maxWeight = std::max(maxWeight, weight);
+    }
+  }
+
+  int nodeCount() const { return static_cast<int>(offsets.size()) - 1; }
+
+  /** Returns the outgoing edges of the given node
+   */
+  std::span<const Edge> edgesOf(int node) const {
+    return std::span<const Edge>(edges.data() + offsets[node], edges.data() + offsets[node + 1]);
+  }
+
+  /** Returns a search engine over the nodes of this graph (see SearchT)
+   */
+  auto search() const {
+    auto identity = [](int node) { return node; };
+    auto expand = [this](int node, auto&& emit) {
+      for (auto& edge : edgesOf(node)) {
+        emit(edge.target, edge.weight);
+      }
+    };
+    return SearchT(static_cast<size_t>(nodeCount()), identity, identity, expand, maxWeight);
+  }
+
+  /** Returns the costs of the cheapest path from->to (or -1 if no such path exists)
+   */
+  int shortestPath(int from, int to) const {
+    return search().findPath(from, [to](int node) { return node == to; });
+  }
+
+  /** Returns the length of the longest path from->to, which visits no node twice (or -1 if no such path exists).
+   *  This is a depth first search over all simple paths with the visited nodes as bit mask, so at most 64 nodes are supported.
+   */
+  int longestSimplePath(int from, int to) const {
+    assert(nodeCount() <= 64);
+    return longestSimplePath(from, to, uint64_t(1) << from);
+  }
+
+
+  std::vector<int> offsets;
+  std::vector<Edge> edges;
+  int maxWeight = 1;
+
+private:
+  int longestSimplePath(int node, int to, uint64_t visited) const {
+    if (node == to) {
+      return 0;
+    }
+
+    int longest = -1;
+    for (auto& edge : edgesOf(node)) {
+      auto bit = uint64_t(1) << edge.target;
+      if ((visited & bit) == 0) {
+        int length = longestSimplePath(edge.target, to, visited | bit);
+        if (length >= 0) {
+          longest = std::max(longest, length + edge.weight);
+        }
+      }
+    }
+    return longest;
+  }
+};
+
+
+/** Graph of a field, in which the junctions and the given endpoints are nodes and the corridors between them are edges
+ */
+struct FieldGraph {
+  Graph graph;
+  std::vector<Vector> nodes; // position of each node
+  FieldT<int> nodeIds = FieldT<int>(0, 0, -1); // node index for each field position or -1
+
+  int nodeAt(const Vector& position) const { return nodeIds.at(position, -1); }
+};
+
+
+/** Contracts the open cells of a field (using the same movement rules as PathFinder) into a FieldGraph.
+ *  Cells with 3 or more open neighbours and the given endpoints become nodes and each single width corridor between two
+ *  nodes becomes a pair of edges weighted with the number of steps. Corridors ending in dead ends are dropped.
+ *  Endpoints outside of the field or on a wall are skipped, so nodeAt() returns -1 for them.
+ */
+template<typename T>
+FieldGraph contractField(const FieldT<T>& field, std::span<const Vector> endpoints) {
+  auto isOpen = [&](const Vector& position) { return field.validPosition(position) && field[position] != '#'; };
+  auto openNeighbours = [&](const Vector& position) {
+    return std::ranges::count_if(Vector::AllSimpleDirections(), [&](const Vector& direction) { return isOpen(position + direction); });
+  };
+
+  FieldGraph result;
+  result.nodeIds = FieldT<int>(field.size.x, field.size.y, -1);
+  auto addNode = [&](const Vector& position) {
+    if (result.nodeIds[position] == -1) {
+      result.nodeIds[position] = static_cast<int>(result.nodes.size());
+      result.nodes.push_back(position);
+    }
+  };
+
+  for (auto& endpoint : endpoints) {
+    if (isOpen(endpoint)) {
+      addNode(endpoint);
+    }
+  }
+  for (int offset = 0; offset < static_cast<int>(field.data.size()); ++offset) {
+    auto position = field.fromOffset(offset);
+    if (isOpen(position) && openNeighbours(position) >= 3) {
+      addNode(position);
+    }
+  }
+
+  // Follow each corridor leaving a node until the next node is reached
+  std::vector<std::tuple<int, int, int>> edgeList;
+  for (int node = 0; node < static_cast<int>(result.nodes.size()); ++node) {
+    for (auto direction : Vector::AllSimpleDirections()) {
+      Vector previous = result.nodes[node];
+      Vector current = previous + direction;
+      int steps = 1;
+      while (isOpen(current) && result.nodeIds[current] == -1) {
+        auto next = std::ranges::find_if(Vector::AllSimpleDirections(), [&](const Vector& step) {
+          return current + step != previous && isOpen(current + step);
+        });
+        if (next == Vector::AllSimpleDirections().end()) {
+          break; // dead end
+        }
+        previous = current;
+        current += *next;
+        ++steps;
+      }
+
+      if (isOpen(current) && result.nodeIds[current] != -1 && result.nodeIds[current] != node) {
+        edgeList.emplace_back(node, result.nodeIds[current], steps);
+      }
+    }
+  }
+
+  result.graph = Graph(static_cast<int>(result.nodes.size()), edgeList);
+  return result;
+}
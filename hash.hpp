@@ -1,6 +1,18 @@
 #pragma once
 
 #include <xhash>
+#include <tuple>
+#include <cstdint>
+#include <cstring>
+#include <concepts>
+#include <ranges>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 // hash_combine as is used by boost
 template <class T>
@@ -9,12 +21,199 @@ void hash_combine(std::size_t& hash, const T& v) {
   hash ^= hasher(v) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
 }
 
+
+/** 64 bit hashing in the style of wyhash. Unlike std::hash (which passes integers through unchanged on MSVC) every result
+ *  is fully mixed, so it can be used directly for open addressing tables and for keys with clustered values (coordinates).
+ *  hashing::hashOf(value) supports (checked in this order)
+ *   - integers, enums, pointers and floating point numbers
+ *   - strings, string_views and C strings
+ *   - types with a tie() member function, which returns a std::tie() of the members that take part in operator==
+ *   - tuples and pairs
+ *   - all other types with a std::hash specialization, whose result is mixed
+ *   - ranges by their elements (contiguous ranges of trivially copyable elements such as std::vector<int> are hashed as bytes)
+ *   - trivially copyable types without padding (e.g. plain structs of ints), which are hashed as bytes
+ *  tie() and std::hash take precedence over hashing the bytes, so members left out of operator== don't change the hash.
+ */
+namespace hashing {
+  namespace impl {
+    constexpr uint64_t Secret[4] = { 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull };
+
+    /** 64 x 64 -> 128 bit multiplication, which replaces a with the low and b with the high half of the product */
+    inline void multiply(uint64_t& a, uint64_t& b) {
+#if defined(_MSC_VER) && defined(_M_X64)
+      a = _umul128(a, b, &b);
+#elif defined(__SIZEOF_INT128__)
+      auto product = static_cast<unsigned __int128>(a) * b;
+      a = static_cast<uint64_t>(product);
+      b = static_cast<uint64_t>(product >> 64);
+#else
+      uint64_t aHigh = a >> 32, aLow = static_cast<uint32_t>(a), bHigh = b >> 32, bLow = static_cast<uint32_t>(b);
+      uint64_t highHigh = aHigh * bHigh, highLow = aHigh * bLow, lowHigh = aLow * bHigh, lowLow = aLow * bLow;
+      uint64_t middle = (lowLow >> 32) + static_cast<uint32_t>(highLow) + lowHigh;
+      a = (middle << 32) | static_cast<uint32_t>(lowLow);
+      b = highHigh + (highLow >> 32) + (middle >> 32);
+#endif
+    }
+
+    /** Xor of both halves of the 128 bit product */
+    inline uint64_t multiplyFold(uint64_t a, uint64_t b) {
+      multiply(a, b);
+      return a ^ b;
+    }
+
+    inline uint64_t read8(const unsigned char* bytes) {
+      uint64_t value;
+      std::memcpy(&value, bytes, 8);
+      return value;
+    }
+
+    inline uint64_t read4(const unsigned char* bytes) {
+      uint32_t value;
+      std::memcpy(&value, bytes, 4);
+      return value;
+    }
+  }
+
+  /** Mixes two 64 bit values into one */
+  inline uint64_t mix(uint64_t a, uint64_t b) { return impl::multiplyFold(a ^ impl::Secret[0], b ^ impl::Secret[1]); }
+
+  /** Combines the hash of the next element into the hash of the previous elements */
+  inline uint64_t combine(uint64_t seed, uint64_t hash) { return impl::multiplyFold(seed ^ impl::Secret[2], hash ^ impl::Secret[3]); }
+
+  /** Hashes length bytes, which are read 48 bytes (three independent lanes) at a time */
+  inline uint64_t hashBytes(const void* data, size_t length, uint64_t seed = 0) {
+    using impl::Secret;
+    using impl::read8;
+    using impl::read4;
+    auto bytes = static_cast<const unsigned char*>(data);
+    seed ^= impl::multiplyFold(seed ^ Secret[0], Secret[1]);
+
+    uint64_t a = 0, b = 0;
+    if (length <= 16) {
+      if (length >= 4) {
+        size_t shift = (length >> 3) << 2;
+        a = read4(bytes) << 32 | read4(bytes + shift);
+        b = read4(bytes + length - 4) << 32 | read4(bytes + length - 4 - shift);
+      } else if (length > 0) {
+        a = static_cast<uint64_t>(bytes[0]) << 16 | static_cast<uint64_t>(bytes[length >> 1]) << 8 | bytes[length - 1];
+      }
+    } else {
+      size_t remaining = length;
+      if (remaining > 48) {
+        uint64_t lane1 = seed, lane2 = seed;
+        do {
+          seed = impl::multiplyFold(read8(bytes) ^ Secret[1], read8(bytes + 8) ^ seed);
+          lane1 = impl::multiplyFold(read8(bytes + 16) ^ Secret[2], read8(bytes + 24) ^ lane1);
+          lane2 = impl::multiplyFold(read8(bytes + 32) ^ Secret[3], read8(bytes + 40) ^ lane2);
+          bytes += 48;
+          remaining -= 48;
+        } while (remaining > 48);
+        seed ^= lane1 ^ lane2;
+      }
+      while (remaining > 16) {
+        seed = impl::multiplyFold(read8(bytes) ^ Secret[1], read8(bytes + 8) ^ seed);
+        bytes += 16;
+        remaining -= 16;
+      }
+      // The last 16 bytes may overlap with the bytes, which have already been hashed
+      a = read8(bytes + remaining - 16);
+      b = read8(bytes + remaining - 8);
+    }
+    a ^= Secret[1];
+    b ^= seed;
+    impl::multiply(a, b);
+    return impl::multiplyFold(a ^ Secret[0] ^ length, b ^ Secret[1]);
+  }
+
+
+  template<typename T>
+  uint64_t hashOf(const T& value);
+
+  namespace impl {
+    template<typename T>
+    constexpr bool hashedAsBytes = std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>;
+
+    /** Contiguous range, whose elements can be hashed as one block of bytes */
+    template<typename T>
+    concept ByteRange = std::ranges::contiguous_range<const T&> && hashedAsBytes<std::ranges::range_value_t<const T&>>;
+
+    template<typename T>
+    concept TupleLike = requires { std::tuple_size<T>::value; };
+
+    template<typename T>
+    concept Tieable = requires(const T& value) { value.tie(); };
+
+    /** Enabled std::hash specialization (the disabled ones aren't default constructible) */
+    template<typename T>
+    concept StdHashable = requires(const T& value) { { std::hash<T>{}(value) } -> std::convertible_to<size_t>; };
+
+    template<typename T>
+    constexpr bool dependentFalse = false;
+  }
+
+  template<typename T>
+  uint64_t hashOf(const T& value) {
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+      return mix(static_cast<uint64_t>(value), 0);
+    } else if constexpr (std::is_pointer_v<T>) {
+      if constexpr (std::is_convertible_v<T, std::string_view>) {
+        std::string_view string(value);
+        return hashBytes(string.data(), string.size());
+      } else {
+        return mix(reinterpret_cast<uintptr_t>(value), 0);
+      }
+    } else if constexpr (std::is_floating_point_v<T>) {
+      T normalized = value == 0 ? T(0) : value; // -0.0 == 0.0
+      return hashBytes(&normalized, sizeof(T));
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      std::string_view string(value);
+      return hashBytes(string.data(), string.size());
+    } else if constexpr (impl::Tieable<T>) {
+      return hashOf(value.tie());
+    } else if constexpr (impl::TupleLike<T> && !std::ranges::range<const T&>) { // std::array is hashed as a range
+      return std::apply([](const auto&... elements) {
+        uint64_t hash = std::tuple_size_v<T>;
+        ((hash = combine(hash, hashOf(elements))), ...);
+        return hash;
+      }, value);
+    } else if constexpr (impl::StdHashable<T>) {
+      return mix(static_cast<uint64_t>(std::hash<T>{}(value)), 0);
+    } else if constexpr (impl::ByteRange<T>) {
+      return hashBytes(std::ranges::data(value), std::ranges::size(value) * sizeof(std::ranges::range_value_t<const T&>));
+    } else if constexpr (std::ranges::input_range<const T&>) {
+      uint64_t hash = 0, count = 0;
+      for (const auto& element : value) {
+        hash = combine(hash, hashOf(element));
+        ++count;
+      }
+      return combine(hash, count);
+    } else if constexpr (impl::hashedAsBytes<T>) {
+      return hashBytes(&value, sizeof(T));
+    } else {
+      static_assert(impl::dependentFalse<T>, "hashOf() needs a tie() member, a std::hash specialization or a padding free trivially copyable type");
+    }
+  }
+
+  /** Hash functor for std::unordered_map and similar containers, e.g. std::unordered_set<std::vector<int>, hashing::Hash<>> */
+  template<typename T = void>
+  struct Hash {
+    size_t operator()(const T& value) const { return static_cast<size_t>(hashOf(value)); }
+  };
+
+  template<>
+  struct Hash<void> {
+    template<typename T>
+    size_t operator()(const T& value) const { return static_cast<size_t>(hashOf(value)); }
+  };
+}
+
+
 // Generic hasher function for arbitrary number of parameters
 template<typename... T>
 size_t hash_all(const T&... param) {
-  size_t hash = 0;
-  (hash_combine(hash, param), ...);
-  return hash;
+  uint64_t hash = sizeof...(T);
+  ((hash = hashing::combine(hash, hashing::hashOf(param))), ...);
+  return static_cast<size_t>(hash);
 }
 
 // Generic hash definition for pair
@@ -26,4 +225,3 @@ namespace std {
     }
   };
 }
-
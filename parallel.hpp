@@ -0,0 +1,133 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <condition_variable>
+
+namespace parallel {
+  /** Minimal thread pool for data parallel loops. The worker threads are created once and sleep between jobs,
+   *  so the pool can be reused for many short loops (e.g. one per simulation step).
+   *  The calling thread participates in each job as worker 0.
+   */
+  class ThreadPool {
+  public:
+    ThreadPool(unsigned threadCount = std::thread::hardware_concurrency()) : threadCount(std::max(threadCount, 1u)) {
+      for (unsigned worker = 1; worker < this->threadCount; ++worker) {
+        threads.emplace_back([this, worker] { workerLoop(worker); });
+      }
+    }
+
+    ~ThreadPool() {
+      {
+        std::lock_guard lock(mutex);
+        stopping = true;
+      }
+      wakeUp.notify_all();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Number of workers (including the calling thread), which is the upper bound for the worker index passed to jobs
+     */
+    unsigned size() const { return threadCount; }
+
+    /** Calls fn(index, worker) for each index in [0, count) and returns once all calls have completed.
+     *  The worker index lies in [0, size()) and identifies the executing thread, so it can be used to select
+     *  per thread buffers. Jobs are not reentrant: fn must not call forEach() on the same pool and must not throw.
+     */
+    template<typename Fn>
+    void forEach(size_t count, Fn&& fn) {
+      if (count == 0) {
+        return;
+      }
+      if (threadCount == 1 || count == 1) {
+        for (size_t index = 0; index < count; ++index) {
+          fn(index, 0u);
+        }
+        return;
+      }
+
+      {
+        std::lock_guard lock(mutex);
+        job = [](void* context, size_t index, unsigned worker) { (*static_cast<std::remove_reference_t<Fn>*>(context))(index, worker); };
+        jobContext = &fn;
+        jobSize = count;
+        nextIndex = 0;
+        activeWorkers = threadCount - 1;
+        ++generation;
+      }
+      wakeUp.notify_all();
+
+      runJob(0);
+
+      std::unique_lock lock(mutex);
+      jobDone.wait(lock, [this] { return activeWorkers == 0; });
+    }
+
+    /** Splits [0, count) into one contiguous band per worker and calls fn(begin, end, worker) for each non empty band
+     */
+    template<typename Fn>
+    void forBands(size_t count, Fn&& fn) {
+      size_t bands = std::min<size_t>(threadCount, count);
+      forEach(bands, [&](size_t band, unsigned worker) {
+        fn(band * count / bands, (band + 1) * count / bands, worker);
+      });
+    }
+
+  private:
+    void runJob(unsigned worker) {
+      for (size_t index; (index = nextIndex.fetch_add(1)) < jobSize;) {
+        job(jobContext, index, worker);
+      }
+    }
+
+    void workerLoop(unsigned worker) {
+      size_t seenGeneration = 0;
+      for (;;) {
+        {
+          std::unique_lock lock(mutex);
+          wakeUp.wait(lock, [&] { return stopping || generation != seenGeneration; });
+          if (stopping) {
+            return;
+          }
+          seenGeneration = generation;
+        }
+
+        runJob(worker);
+
+        std::lock_guard lock(mutex);
+        if (--activeWorkers == 0) {
+          jobDone.notify_one();
+        }
+      }
+    }
+
+    unsigned threadCount;
+
+    std::mutex mutex;
+    std::condition_variable wakeUp, jobDone;
+    bool stopping = false;
+    size_t generation = 0;
+
+    void (*job)(void*, size_t, unsigned) = nullptr;
+    void* jobContext = nullptr;
+    size_t jobSize = 0;
+    std::atomic<size_t> nextIndex = 0;
+    unsigned activeWorkers = 0;
+
+    std::vector<std::jthread> threads; // declared last, so the threads are joined before the members above are destroyed
+  };
+
+
+  /** Shared pool with one worker per hardware thread
+   */
+  inline ThreadPool& pool() {
+    static ThreadPool instance;
+    return instance;
+  }
+}
@@ -1,39 +1,307 @@
 #pragma once
 
-#include <set>
+#include <bit>
+#include <span>
+#include <queue>
+#include <tuple>
 #include <vector>
-#include <unordered_map>
 #include <ranges>
+#include <optional>
+#include <type_traits>
+#include <initializer_list>
 
 
 #include "field.hpp"
+#include "search.hpp"
+#include "bitfield.hpp"
+#include "parallel.hpp"
 
-/** Path finding class for Fields
+/** Heuristics for PathFinderT::findPathAStar(), which estimate the remaining costs from a position to the target.
+ *  A heuristic must never overestimate the remaining costs and must be consistent for the chosen neighbourhood.
  */
+namespace heuristic {
+  /** Exact lower bound for 4-connected grids (PathFinderT::directions = Vector::AllSimpleDirections())
+   */
+  struct StepDistance {
+    int operator()(const Vector& position, const Vector& to) const { return position.stepDistance(to); }
+  };
 
-template<typename T>
-struct PathFinderT {
-  PathFinderT(FieldT<T>& field) : field(field) {}
-  PathFinderT(FieldT<T>& field, Vector from, Vector to) : field(field), from(from), to(to) {}
+  /** Exact lower bound for 8-connected grids (PathFinderT::directions = Vector::AllDirections())
+   */
+  struct Chebyshev {
+    int operator()(const Vector& position, const Vector& to) const { return position.chebyshevDistance(to); }
+  };
+
+  /** No estimation at all, which turns A* into Dijkstra's algorithm
+   */
+  struct None {
+    int operator()(const Vector&, const Vector&) const { return 0; }
+  };
+}
+
+
+namespace impl {
+  template<typename T>
+  struct FieldEncode {
+    int operator()(const Vector& position) const { return field->toOffset(position); }
+    const FieldT<T>* field;
+  };
+
+  template<typename T>
+  struct FieldDecode {
+    Vector operator()(int offset) const { return field->fromOffset(offset); }
+    const FieldT<T>* field;
+  };
+
+  /** Expands into all directions of the path finder, which do not lead out of the field or into a wall.
+   *  Unlike fillDistances() this deliberately loops over the directions at runtime: emit (the cost update and queue push)
+   *  dominates here, and unrolling it 4 or 8 times with forEachNeighbour() or dispatching on the direction table was
+   *  measured 15-20% slower than inlining it once into this loop.
+   */
+  template<typename Finder>
+  struct FieldExpand {
+    template<typename Emit>
+    void operator()(const Vector& position, Emit&& emit) const {
+      for (auto direction : finder->directions) {
+        auto nextPosition = position + direction;
+        if (finder->isOpen(nextPosition)) {
+          emit(nextPosition, 1);
+        }
+      }
+    }
+    const Finder* finder;
+  };
+
+  /** Jump point search expansion: instead of the neighbours only the next jump points in each direction are emitted,
+   *  which skips the symmetric runs of open cells in between. The direction we came from is taken from the
+   *  predecessor of the expanded position. In 4-connected grids vertical moves take the role of diagonal moves,
+   *  so horizontal runs are probed from each cell of a vertical run.
+   *  Straight runs are scanned 64 cells at a time on bit rows of the open cells (and on the transposed bits for the
+   *  vertical runs of 8-connected grids), which prepare() builds before each search.
+   */
+  template<typename Finder>
+  struct JumpPointExpand {
+    using Word = BitField::Word;
+    static constexpr int WordBits = BitField::WordBits;
+
+    template<typename Emit>
+    void operator()(const Vector& position, Emit&& emit) const {
+      auto predecessor = finder->workspace->predecessors[finder->field.toOffset(position)];
+      auto direction = predecessor != -1 ? position.compare(finder->field.fromOffset(predecessor)) : Vector::Zero;
+
+      auto jumpTo = [&](const Vector& jumpDirection) {
+        auto jumpPoint = jump(position, jumpDirection);
+        if (jumpPoint) {
+          emit(*jumpPoint, jumpPoint->chebyshevDistance(position));
+        }
+      };
+
+      if (direction == Vector::Zero) {
+        for (auto nextDirection : finder->directions) {
+          jumpTo(nextDirection); // start position
+        }
+      } else if (direction.x != 0 && direction.y != 0) {
+        // Diagonal move: natural neighbours and the forced ones behind blocked cells
+        jumpTo(direction);
+        jumpTo(Vector(direction.x, 0));
+        jumpTo(Vector(0, direction.y));
+        if (!open(position - Vector(direction.x, 0)) && open(position + Vector(-direction.x, direction.y))) {
+          jumpTo(Vector(-direction.x, direction.y));
+        }
+        if (!open(position - Vector(0, direction.y)) && open(position + Vector(direction.x, -direction.y))) {
+          jumpTo(Vector(direction.x, -direction.y));
+        }
+      } else if (diagonal) {
+        // Straight move in an 8-connected grid: diagonals are only forced around blocked cells
+        jumpTo(direction);
+        for (auto side : { direction.rotateCW(), direction.rotateCCW() }) {
+          if (!open(position + side) && open(position + direction + side)) {
+            jumpTo(direction + side);
+          }
+        }
+      } else if (direction.y != 0) {
+        // Vertical move in a 4-connected grid
+        jumpTo(direction);
+        jumpTo(Vector::Left);
+        jumpTo(Vector::Right);
+      } else {
+        // Horizontal move in a 4-connected grid: vertical moves are only forced behind blocked cells
+        jumpTo(direction);
+        for (auto side : { Vector::Up, Vector::Down }) {
+          if (open(position + side) && !open(position - direction + side)) {
+            jumpTo(side);
+          }
+        }
+      }
+    }
+
+    /** Builds the bit rows and columns of the open cells for the field and directions of the next search. For 4-connected
+     *  grids it also marks the cells, from which a horizontal probe reaches a cell with forced neighbours before a blocked
+     *  cell, so that vertical runs are scanned word by word as well.
+     */
+    void prepare() {
+      diagonal = finder->directions.size() > 4;
+      rows = BitField(finder->field, [](const auto& cell) { return cell != '#'; });
+      columns = rows.transposed();
+      if (diagonal) {
+        probeColumns = BitField();
+        return;
+      }
+
+      BitField probes(rows.size.x, rows.size.y);
+      for (int y = 0; y < rows.size.y; ++y) {
+        auto* row = &probes.words[static_cast<size_t>(y) * rows.rowWords];
+        bool next = false; // a probe from the last cell of the word to the right stops at a forced cell
+        for (int word = rows.rowWords - 1; word >= 0; --word) {
+          int first = word * WordBits;
+          auto stops = firstStops(forced(rows, y, first, 1), ~rows.bitsAt(y, first), 1, next);
+          row[word] = (stops >> 1) | (Word(next) << (WordBits - 1));
+          next = stops & 1;
+        }
+        next = false; // a probe from the first cell of the word to the left stops at a forced cell
+        for (int word = 0; word < rows.rowWords; ++word) {
+          int first = word * WordBits;
+          auto stops = firstStops(forced(rows, y, first, -1), ~rows.bitsAt(y, first), -1, next);
+          row[word] = (row[word] | (stops << 1) | Word(next)) & rows.bitsAt(y, first);
+          next = stops >> (WordBits - 1);
+        }
+      }
+      probeColumns = probes.transposed();
+    }
+
+    bool open(const Vector& position) const { return finder->isOpen(position); }
+
+    /** Moves from position into direction until a jump point is found (a position with forced neighbours or the target)
+     */
+    std::optional<Vector> jump(Vector position, const Vector& direction) const {
+      if (direction.x == 0 || direction.y == 0) {
+        return straightJump(position, direction);
+      }
+      for (;;) {
+        position += direction;
+        if (!open(position)) {
+          return std::nullopt;
+        }
+        if (position == finder->to) {
+          return position;
+        }
+        if ((!open(position - Vector(direction.x, 0)) && open(position + Vector(-direction.x, direction.y))) ||
+            (!open(position - Vector(0, direction.y)) && open(position + Vector(direction.x, -direction.y))) ||
+            straightJump(position, Vector(direction.x, 0)) || straightJump(position, Vector(0, direction.y))) {
+          return position;
+        }
+      }
+    }
+
+    /** Horizontal or vertical jump, which scans the rows or columns word by word. In 4-connected grids vertical runs
+     *  also stop where a horizontal probe reaches a forced cell (probeColumns) or the target.
+     */
+    std::optional<Vector> straightJump(const Vector& position, const Vector& direction) const {
+      auto& to = finder->to;
+      int distance = 0;
+      if (direction.y == 0) {
+        distance = scan(rows, nullptr, position.y, position.x, direction.x, to.y == position.y ? to.x : -1);
+      } else {
+        bool target = to.x == position.x || (!diagonal && clearRun(to.y, position.x, to.x));
+        distance = scan(columns, diagonal ? nullptr : &probeColumns, position.x, position.y, direction.y, target ? to.y : -1);
+      }
+      return distance != 0 ? std::optional<Vector>(position + direction * distance) : std::nullopt;
+    }
+
+    /** Returns the distance from start to the first cell of the run in direction step (+1 or -1) along the given bit row,
+     *  which is the target, is set in probes or has forced neighbours, or 0 if a blocked cell comes first.
+     */
+    int scan(const BitField& bits, const BitField* probes, int row, int start, int step, int target) const {
+      // Each chunk holds the next 64 cells (bit i = cell first + i), which are walked upwards or downwards
+      for (int first = step > 0 ? start + 1 : start - WordBits; ; first += step * WordBits) {
+        Word blocked = ~bits.bitsAt(row, first);
+        Word stops = forced(bits, row, first, step) | (probes ? probes->bitsAt(row, first) : 0);
+        if (target >= first && target < first + WordBits) {
+          stops |= Word(1) << (target - first);
+        }
+
+        // Number of cells before the first stop and before the first blocked cell
+        int stop = step > 0 ? std::countr_zero(stops) : std::countl_zero(stops);
+        int wall = step > 0 ? std::countr_zero(blocked) : std::countl_zero(blocked);
+        if (stop < wall) {
+          return step > 0 ? first + stop - start : start - (first + WordBits - 1 - stop);
+        }
+        if (wall < WordBits) {
+          return 0;
+        }
+      }
+    }
 
-  struct ExpandEntry {
-    ExpandEntry(Vector pos, int cost) : position(pos), cost(cost) {}
+    /** Cells among the 64 cells from first, which have forced neighbours in one of the adjacent rows for a move in
+     *  direction step: the adjacent row is blocked next to the cell and open one cell ahead (8-connected grids)
+     *  or it is open next to the cell, but blocked one cell behind (4-connected grids).
+     */
+    Word forced(const BitField& bits, int row, int first, int step) const {
+      auto side = [&](int sideRow) {
+        Word cells = bits.bitsAt(sideRow, first);
+        return diagonal ? ~cells & bits.bitsAt(sideRow, first + step) : cells & ~bits.bitsAt(sideRow, first - step);
+      };
+      return side(row - 1) | side(row + 1);
+    }
 
-    // Entries are ordered based on their cost to expand the low cost entries first
-    // We must include the position as well because we use an std::set<> and 
-    // we would otherwise not include expand entries for different positions if they have the same costs
-    std::strong_ordering operator<=>(const ExpandEntry& other) const {
-      auto result = cost <=> other.cost;
-      if (result == std::strong_ordering::equal) {
-        result = position <=> other.position;
+    /** Marks the cells of a word, for which the first forced or blocked cell in direction step (starting at the cell itself)
+     *  is a forced one. next is the result for the cell after the word.
+     */
+    static Word firstStops(Word forced, Word blocked, int step, bool next) {
+      Word events = forced | blocked, result = forced & ~blocked, free = ~events;
+      // Occluded fill: spreads the forced cells backwards over the cells without events
+      for (int shift = 1; shift < WordBits; shift *= 2) {
+        result |= free & (step > 0 ? result >> shift : result << shift);
+        free &= step > 0 ? free >> shift : free << shift;
+      }
+      if (next) {
+        // The cells behind the last event in direction step
+        result |= events == 0 ? ~Word(0) : step > 0 ? ~(~Word(0) >> std::countl_zero(events)) : (events & (~events + 1)) - 1;
       }
       return result;
     }
 
+    /** Tests if the cells between x (exclusive) and the target column (inclusive) of the given row are all open
+     */
+    bool clearRun(int row, int x, int target) const {
+      for (int first = std::min(x + 1, target), last = std::max(x - 1, target); first <= last; first += WordBits) {
+        int count = std::min(WordBits, last - first + 1);
+        Word mask = count == WordBits ? ~Word(0) : (Word(1) << count) - 1;
+        if (~rows.bitsAt(row, first) & mask) {
+          return false;
+        }
+      }
+      return true;
+    }
 
-    Vector position;
-    int cost; // up until that position on the current path
+    const Finder* finder;
+    bool diagonal = false;
+    BitField rows, columns, probeColumns; // open cells and probe stops, columns[Vector(y, x)] is the cell at (x, y)
   };
+}
+
+
+/** Path finding class for Fields, which is the specialization of SearchT for positions in a field
+ *  where each step into a neighbouring non wall ('#') position costs 1.
+ *  The Expand policy determines the successors of a position (neighbours or jump points).
+ */
+template<typename T, template<typename> typename Expand = impl::FieldExpand>
+struct PathFinderT : SearchT<impl::FieldEncode<T>, impl::FieldDecode<T>, Expand<PathFinderT<T, Expand>>> {
+  using Base = SearchT<impl::FieldEncode<T>, impl::FieldDecode<T>, Expand<PathFinderT<T, Expand>>>;
+  static constexpr int Unreachable = Base::Unreachable;
+  static constexpr bool JumpPoints = std::is_same_v<Expand<PathFinderT>, impl::JumpPointExpand<PathFinderT>>;
+
+  /** The optional workspace holds the search tables and can be shared by many short lived path finders
+   */
+  PathFinderT(FieldT<T>& field, SearchWorkspace* workspace = nullptr) : Base(field.data.size(), { &field }, { &field }, { this }, 1, workspace), field(field) {}
+  PathFinderT(FieldT<T>& field, Vector from, Vector to, SearchWorkspace* workspace = nullptr) : PathFinderT(field, workspace) {
+    this->from = from;
+    this->to = to;
+  }
+
+  // The expand functor refers to this instance
+  PathFinderT(const PathFinderT&) = delete;
+  PathFinderT& operator=(const PathFinderT&) = delete;
 
 
   int findPath(Vector from, Vector to, bool expandAllFields = false) {
@@ -46,99 +314,319 @@ struct PathFinderT {
   /** Calculates the minimal path from->to and returns the costs (or -1 if no such path exists)
    */
   int findPath(bool expandAllFields = false) {
-    std::set<ExpandEntry> expandList = { {from, 0} };
-    int pathCost = -1;
-    while (!expandList.empty()) {
-      auto entry = *expandList.begin();
-      expandList.erase(expandList.begin());
-
-      if (!updateCosts(entry)) {
-        // DO not expand this node, because we already know a cheaper (or equally expensive) path to this node
-        // which thus has already been expanded
-        continue;
-      }
+    if (!prepare()) {
+      return -1;
+    }
+    return Base::findPath(from, [this](const Vector& position) { return position == to; }, expandAllFields);
+  }
 
-      if (entry.position == to) {
-        if (!expandAllFields) {
-          // We are expanding the end tile -> we are done expanding
-          return entry.cost;
-        } else {
-          pathCost = entry.cost;
+
+  template<typename Heuristic = heuristic::StepDistance>
+  int findPathAStar(Vector from, Vector to, Heuristic heuristic = {}) {
+    this->from = from;
+    this->to = to;
+    return findPathAStar(heuristic);
+  }
+
+  /** Same as findPath(), but expands the positions in the order of their cost plus the estimated remaining costs,
+   *  which is given by heuristic(position, to). This only expands the positions, which can still be part of a path
+   *  cheaper than the known one, so compare expandedNodes with a findPath() run to see how much work was saved.
+   */
+  template<typename Heuristic = heuristic::StepDistance>
+  int findPathAStar(Heuristic heuristic = {}) {
+    if (!prepare()) {
+      return -1;
+    }
+    return Base::findPathAStar(from, [this](const Vector& position) { return position == to; },
+                               [&](const Vector& position) { return heuristic(position, to); });
+  }
+
+  /** Returns the cheapest path from->to after findPath has been called
+   */
+  std::vector<Vector> getCheapestPath() const {
+    std::vector<Vector> path;
+    if (getCost(to) == Unreachable) {
+      return path;
+    }
+
+    for (auto& position : Base::getPath(to)) {
+      // A jump point search only records the jump points, so fill in the straight or diagonal runs between them
+      if (!path.empty()) {
+        for (auto step = position.compare(path.back()); path.back() + step != position; ) {
+          path.push_back(path.back() + step);
         }
       }
+      path.push_back(position);
+    }
+    return path;
+  }
+
+
+  /** Returns the number of distinct cheapest paths from->to (modulo 2^64) after findPath has been called.
+   *  This and onAnyCheapestPath() need all cheapest paths, which a jump point search prunes, so they are not available there.
+   */
+  uint64_t countCheapestPaths() const requires (!JumpPoints) {
+    return getCost(to) != Unreachable ? Base::countCheapestPaths(to) : 0;
+  }
+
+  /** Returns a flag for each field offset, which is set if the position lies on any cheapest path from->to
+   */
+  std::vector<bool> onAnyCheapestPath() const requires (!JumpPoints) {
+    return getCost(to) != Unreachable ? Base::onCheapestPaths(to) : std::vector<bool>(field.data.size(), false);
+  }
+
+
+  /** Returns the cost of the cheapest known path to the given position (or Unreachable).
+   *  A jump point search only assigns costs to the jump points.
+   */
+  int getCost(Vector position) const {
+    return field.validPosition(position) ? Base::getCost(position) : Unreachable;
+  }
+
+  /** Neighbours of positions within the field don't need the bounds check if the field is padded with walls */
+  bool isOpen(const Vector& position) const { return (wallPadding || field.validPosition(position)) && field[position] != '#'; }
+
+
+  FieldT<T>& field;
+  Vector from, to;
+  std::span<const Vector> directions = Vector::AllSimpleDirections(); // use Vector::AllDirections() for 8-connected grids
+
+private:
+  bool wallPadding = false; // the field is surrounded by enough '#' sentinels for all directions
+  /** Resets the search state and returns false if the search cannot start at from
+   */
+  bool prepare() {
+    this->stateCount = field.data.size(); // the field may have been resized since construction
+    wallPadding = field.isPadded() && field.sentinel() == '#' &&
+                  std::ranges::all_of(directions, [&](const Vector& direction) { return direction.chebyshevDistance(Vector::Zero) <= field.padding; });
+    if constexpr (requires { this->expand.prepare(); }) {
+      this->expand.prepare();
+    }
+    if (!field.validPosition(from)) {
+      this->reset();
+      return false;
+    }
+    return true;
+  }
+};
+
+using PathFinder = PathFinderT<char>;
+
+/** Jump point search variant for uniform cost grids, which only expands the positions where a cheapest path may turn.
+ *  It has the same interface as PathFinderT and supports 4-connected and 8-connected (directions = Vector::AllDirections())
+ *  grids, but getCost() is only defined for the jump points and countCheapestPaths()/onAnyCheapestPath() don't exist.
+ *  It pays off on open areas between larger obstacles, while scattered single wall cells give almost every cell forced
+ *  neighbours, which makes it slower than PathFinderT (see bench/jumppoint.cpp).
+ */
+template<typename T>
+using JumpPointPathFinderT = PathFinderT<T, impl::JumpPointExpand>;
+
+using JumpPointPathFinder = JumpPointPathFinderT<char>;
 
-      // We have 4 paths to expand one in each direction
-      for (auto direction : Vector::AllSimpleDirections()) {
-        auto nextPosition = entry.position + direction;
-        if (field.validPosition(nextPosition) && field[nextPosition] != '#') {
-          // No wall -> we can expand in that direction
-          expandList.insert({ nextPosition, entry.cost + 1 });
+
+namespace impl {
+  /** Breadth first search from source over all non wall positions, which writes the number of steps into distances
+   *  (-1 for unreachable positions). The queue is passed in to reuse its storage between searches.
+   */
+  template<typename T, typename Layout>
+  void fillDistances(const FieldT<T, Layout>& field, Vector source, FieldT<int, Layout>& distances, std::vector<int>& queue) {
+    distances.assign(field.size, -1);
+    queue.clear();
+    if (!field.validPosition(source)) {
+      return;
+    }
+
+    bool wallPadding = field.isPadded() && field.sentinel() == '#';
+    distances[source] = 0;
+    queue.push_back(field.toOffset(source));
+    for (size_t head = 0; head < queue.size(); ++head) {
+      auto position = field.fromOffset(queue[head]);
+      int nextDistance = distances[position] + 1;
+      forEachNeighbour(position, [&, nextDistance](const Vector& nextPosition) {
+        if ((wallPadding || field.validPosition(nextPosition)) && field[nextPosition] != '#' && distances[nextPosition] == -1) {
+          distances[nextPosition] = nextDistance;
+          queue.push_back(field.toOffset(nextPosition));
         }
+      });
+    }
+  }
+}
+
+/** Calculates the number of steps from each source to every position of the field (-1 if unreachable) using the
+ *  same movement rules as PathFinder. The independent searches are distributed across the thread pool.
+ */
+template<typename T, typename Layout>
+std::vector<FieldT<int, Layout>> distanceFields(const FieldT<T, Layout>& field, std::span<const Vector> sources, parallel::ThreadPool& pool = parallel::pool()) {
+  std::vector<FieldT<int, Layout>> fields(sources.size(), FieldT<int, Layout>(0, 0, -1));
+  std::vector<std::vector<int>> queues(pool.size());
+  pool.forEach(sources.size(), [&](size_t source, unsigned worker) {
+    impl::fillDistances(field, sources[source], fields[source], queues[worker]);
+  });
+  return fields;
+}
+
+/** Calculates the number of steps between all pairs of sources (-1 if unreachable) and returns them as
+ *  matrix where matrix[Vector(to, from)] is the distance from sources[from] to sources[to].
+ */
+template<typename T, typename Layout>
+FieldT<int> distanceMatrix(const FieldT<T, Layout>& field, std::span<const Vector> sources, parallel::ThreadPool& pool = parallel::pool()) {
+  int count = static_cast<int>(sources.size());
+  FieldT<int> matrix(count, count, -1);
+  std::vector<FieldT<int, Layout>> distances(pool.size(), FieldT<int, Layout>(0, 0, -1));
+  std::vector<std::vector<int>> queues(pool.size());
+  pool.forEach(sources.size(), [&](size_t source, unsigned worker) {
+    impl::fillDistances(field, sources[source], distances[worker], queues[worker]);
+    for (int to = 0; to < count; ++to) {
+      matrix[Vector(to, static_cast<int>(source))] = distances[worker].at(sources[to], -1);
+    }
+  });
+  return matrix;
+}
+
+
+/** Incremental path finder (Lifelong Planning A*) for a fixed start and target on a changing field.
+ *  The search state is kept between findPath() calls. Changing cells through setCell() only marks the cell and
+ *  its neighbours as inconsistent, so the next findPath() repairs only the part of the cost map, which is affected
+ *  by the change instead of searching from scratch. Uses the same movement rules as PathFinder.
+ */
+template<typename T>
+struct IncrementalPathFinderT {
+  static constexpr int Unreachable = std::numeric_limits<int>::max() / 2; // leaves room for adding costs
+
+  IncrementalPathFinderT(FieldT<T>& field, Vector from, Vector to) : field(field), from(from), to(to) {
+    costs.assign(field.data.size(), Unreachable);
+    lookahead.assign(field.data.size(), Unreachable);
+    if (field.validPosition(from)) {
+      lookahead[field.toOffset(from)] = 0;
+      push(from);
+    }
+  }
+
+  /** Changes the value of a field cell and marks the affected positions for the next findPath() call
+   */
+  void setCell(Vector position, const T& value) {
+    field[position] = value;
+    updatePosition(position);
+    forEachNeighbour(position, [&](const Vector& neighbour) {
+      if (field.validPosition(neighbour)) {
+        updatePosition(neighbour);
       }
+    });
+  }
+
+  /** Calculates the minimal path from->to for the current field and returns the costs (or -1 if no such path exists)
+   */
+  int findPath() {
+    expandedNodes = 0;
+    if (!field.validPosition(to)) {
+      return -1;
     }
 
-    return pathCost;
+    auto target = field.toOffset(to);
+    while (!openList.empty()) {
+      auto [key, position] = openList.top();
+      auto offset = field.toOffset(position);
+      if (costs[offset] == lookahead[offset] || key != calculateKey(position)) {
+        openList.pop(); // outdated entry
+        continue;
+      }
+      if (key >= calculateKey(to) && costs[target] == lookahead[target]) {
+        break; // all remaining entries are more expensive than the consistent target
+      }
+
+      openList.pop();
+      ++expandedNodes;
+      if (costs[offset] > lookahead[offset]) {
+        costs[offset] = lookahead[offset];
+      } else {
+        costs[offset] = Unreachable;
+        updatePosition(position);
+      }
+      forEachNeighbour(position, [&](const Vector& neighbour) {
+        if (field.validPosition(neighbour)) {
+          updatePosition(neighbour);
+        }
+      });
+    }
+
+    return costs[target] != Unreachable ? costs[target] : -1;
   }
 
-  /** Returns greedily the cheapest path from->to after findPath has been called
+  /** Returns the cheapest path from->to after findPath has been called
    */
   std::vector<Vector> getCheapestPath() const {
     std::vector<Vector> path;
-
-    if (costMap.find(to) == costMap.end()) {
-      return path; // no path found -> return empty vector to signal this
+    if (getCost(to) == Unreachable) {
+      return path;
     }
 
-    int cost = getCost(to);
     for (Vector pos = to; pos != from; ) {
       path.push_back(pos);
-
-      for (auto direction : Vector::AllSimpleDirections()) {
-        auto prevPos = pos + direction;
-        auto prevCost = getCost(prevPos);
-        if (prevCost < cost) {
-          cost = prevCost;
-          pos = prevPos;
-          break; // found the next step in the cheapest path
+      Vector previous = pos;
+      forEachNeighbour(pos, [&](const Vector& neighbour) {
+        if (getCost(neighbour) < getCost(previous)) {
+          previous = neighbour;
         }
+      });
+      if (previous == pos) {
+        return {}; // cannot happen for a consistent search state
       }
+      pos = previous;
     }
     path.push_back(from);
     std::ranges::reverse(path);
     return path;
   }
 
+  /** Returns the cost of the cheapest known path to the given position (or Unreachable)
+   */
+  int getCost(Vector position) const {
+    return field.validPosition(position) ? costs[field.toOffset(position)] : Unreachable;
+  }
 
 
+  FieldT<T>& field;
+  Vector from, to;
+  std::vector<int> costs; // g-values indexed by field offset
+  std::vector<int> lookahead; // rhs-values: costs based on the neighbours' costs
+  size_t expandedNodes = 0; // number of positions expanded by the last findPath() call
 
-  int getCost(Vector position) const {
-    auto pos = costMap.find(position);
-    return (pos != costMap.end()) ? pos->second : std::numeric_limits<int>::max();
+private:
+  using Key = std::pair<int, int>;
+  using Entry = std::pair<Key, Vector>;
+
+  Key calculateKey(const Vector& position) const {
+    auto offset = field.toOffset(position);
+    int cost = std::min(costs[offset], lookahead[offset]);
+    return { cost + position.stepDistance(to), cost };
   }
 
-  /** Add new/lower costs to each position or return false if the cost map already
-   *  contains lower costs
+  void push(const Vector& position) {
+    openList.emplace(calculateKey(position), position);
+  }
+
+  /** Recalculates the lookahead costs of a position and queues it if it became inconsistent
    */
-  bool updateCosts(const ExpandEntry& fromEntry) {
-    auto pos = costMap.find(fromEntry.position);
-    if (pos != costMap.end()) {
-      if (pos->second <= fromEntry.cost) {
-        return false; // no update to more expensive path
-      } else {
-        pos->second = fromEntry.cost;
+  void updatePosition(const Vector& position) {
+    auto offset = field.toOffset(position);
+    if (position != from) {
+      int cost = Unreachable;
+      if (field[position] != '#') {
+        forEachNeighbour(position, [&](const Vector& neighbour) {
+          if (field.validPosition(neighbour) && (field[neighbour] != '#' || neighbour == from)) { // like PathFinder we may start on a wall
+            cost = std::min(cost, costs[field.toOffset(neighbour)] + 1);
+          }
+        });
       }
-    } else {
-      // new path with yet unknown cost
-      costMap.emplace(fromEntry.position, fromEntry.cost);
+      lookahead[offset] = std::min(cost, Unreachable);
+    }
+    if (costs[offset] != lookahead[offset]) {
+      push(position);
     }
-    return true;
   }
 
-
-  FieldT<T>& field;
-  Vector from, to;
-  std::unordered_map<Vector/*position*/, int/*cost*/> costMap;
+  // Min heap with lazy deletion: outdated entries are skipped when they reach the top
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> openList;
 };
 
-using PathFinder = PathFinderT<char>;
-
+using IncrementalPathFinder = IncrementalPathFinderT<char>;
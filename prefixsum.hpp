@@ -0,0 +1,188 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "field.hpp"
+#include "parallel.hpp"
+
+/** Summed area table (2D prefix sums) over a projection of a field, which answers the sum over any rectangle in O(1).
+ *  projection(cell) maps each cell to the value being summed (e.g. [](char c) { return c == '#'; } to count walls).
+ *  After changing cells, markDirty() their rows and call rebuild(), which only projects the dirty rows again.
+ */
+template<typename Sum = int64_t>
+struct SummedAreaTableT {
+  SummedAreaTableT() : size(0, 0) {}
+
+  template<typename T, typename Projection>
+  SummedAreaTableT(const FieldT<T>& field, Projection&& projection, parallel::ThreadPool& pool = parallel::pool()) : size(field.size) {
+    rowSums.assign(static_cast<size_t>(size.x + 1) * (size.y + 1), 0);
+    table.assign(rowSums.size(), 0);
+    dirtyRows.assign(size.y, true);
+    rebuild(field, projection, pool);
+  }
+
+  /** Sum of all cells in the rectangle from min to max (inclusive), which is clipped to the field */
+  Sum sum(Vector min, Vector max) const {
+    min = Vector(std::max(min.x, 0), std::max(min.y, 0));
+    max = Vector(std::min(max.x, size.x - 1), std::min(max.y, size.y - 1));
+    if (min.x > max.x || min.y > max.y) {
+      return 0;
+    }
+    return at(max.x + 1, max.y + 1) - at(min.x, max.y + 1) - at(max.x + 1, min.y) + at(min.x, min.y);
+  }
+
+  /** Sum of the rectangle of the given size with its top left corner at topLeft */
+  Sum sumAt(const Vector& topLeft, const Vector& rectangleSize) const { return sum(topLeft, topLeft + rectangleSize - Vector(1, 1)); }
+
+  /** Sum of all cells */
+  Sum total() const { return at(size.x, size.y); }
+
+  /** Marks a row, whose cells have changed since the last (re)build */
+  void markDirty(int row) { dirtyRows[row] = true; }
+
+  /** Projects the dirty rows again and updates the table from the first dirty row downwards.
+   *  The row and column passes are split into bands across the thread pool.
+   */
+  template<typename T, typename Projection>
+  void rebuild(const FieldT<T>& field, Projection&& projection, parallel::ThreadPool& pool = parallel::pool()) {
+    auto firstDirty = std::find(dirtyRows.begin(), dirtyRows.end(), true);
+    if (firstDirty == dirtyRows.end()) {
+      return;
+    }
+    int firstRow = static_cast<int>(std::distance(dirtyRows.begin(), firstDirty));
+
+    // Horizontal prefix sums of each dirty row
+    forBands(pool, size.y - firstRow, [&](int begin, int end) {
+      for (int y = firstRow + begin; y < firstRow + end; ++y) {
+        if (!dirtyRows[y]) {
+          continue;
+        }
+        Sum* row = &rowSums[index(0, y + 1)];
+        for (int x = 0; x < size.x; ++x) {
+          row[x + 1] = row[x] + static_cast<Sum>(projection(field[Vector(x, y)]));
+        }
+      }
+    });
+
+    // Vertical accumulation of the rows in bands of columns
+    forBands(pool, size.x + 1, [&](int begin, int end) {
+      for (int y = firstRow + 1; y <= size.y; ++y) {
+        const Sum* above = &table[index(0, y - 1)];
+        const Sum* row = &rowSums[index(0, y)];
+        Sum* out = &table[index(0, y)];
+        for (int x = begin; x < end; ++x) {
+          out[x] = above[x] + row[x];
+        }
+      }
+    });
+    std::fill(dirtyRows.begin(), dirtyRows.end(), false);
+  }
+
+
+  Vector size;
+
+private:
+  static constexpr size_t MinParallelCells = 1 << 16;
+
+  size_t index(int x, int y) const { return static_cast<size_t>(y) * (size.x + 1) + x; }
+  Sum at(int x, int y) const { return table[index(x, y)]; }
+
+  template<typename Fn>
+  void forBands(parallel::ThreadPool& pool, int count, Fn&& fn) {
+    if (static_cast<size_t>(size.x) * size.y < MinParallelCells) {
+      fn(0, count);
+    } else {
+      pool.forBands(count, [&](size_t begin, size_t end, unsigned) { fn(static_cast<int>(begin), static_cast<int>(end)); });
+    }
+  }
+
+  std::vector<Sum> rowSums; // (size.x + 1) x (size.y + 1) horizontal prefix sums with a zero first row and column
+  std::vector<Sum> table;   // (size.x + 1) x (size.y + 1) where table[x, y] is the sum of all cells left of x and above y
+  std::vector<bool> dirtyRows;
+};
+
+using SummedAreaTable = SummedAreaTableT<>;
+
+
+/** Two dimensional Fenwick tree (binary indexed tree) for workloads with many point updates between rectangle queries.
+ *  Both set()/add() and sum() take O(log(width) * log(height)).
+ */
+template<typename Sum = int64_t>
+struct FenwickTree2DT {
+  FenwickTree2DT(int width = 0, int height = 0) : size(width, height) {
+    tree.assign(static_cast<size_t>(width + 1) * (height + 1), 0);
+    values.assign(static_cast<size_t>(width) * height, 0);
+  }
+
+  /** Builds the tree in O(width * height) from the projected cells */
+  template<typename T, typename Projection>
+  FenwickTree2DT(const FieldT<T>& field, Projection&& projection) : FenwickTree2DT(field.size.x, field.size.y) {
+    for (int y = 0; y < size.y; ++y) {
+      for (int x = 0; x < size.x; ++x) {
+        values[y * size.x + x] = static_cast<Sum>(projection(field[Vector(x, y)]));
+        tree[index(x + 1, y + 1)] = values[y * size.x + x];
+      }
+    }
+    // Push each node's sum to its parent, first along x then along y
+    for (int y = 1; y <= size.y; ++y) {
+      for (int x = 1; x <= size.x; ++x) {
+        int parent = x + (x & -x);
+        if (parent <= size.x) {
+          tree[index(parent, y)] += tree[index(x, y)];
+        }
+      }
+    }
+    for (int y = 1; y <= size.y; ++y) {
+      int parent = y + (y & -y);
+      for (int x = 1; parent <= size.y && x <= size.x; ++x) {
+        tree[index(x, parent)] += tree[index(x, y)];
+      }
+    }
+  }
+
+  void add(const Vector& pos, Sum delta) {
+    values[pos.y * size.x + pos.x] += delta;
+    for (int y = pos.y + 1; y <= size.y; y += y & -y) {
+      for (int x = pos.x + 1; x <= size.x; x += x & -x) {
+        tree[index(x, y)] += delta;
+      }
+    }
+  }
+
+  void set(const Vector& pos, Sum value) { add(pos, value - get(pos)); }
+  Sum get(const Vector& pos) const { return values[pos.y * size.x + pos.x]; }
+
+  /** Sum of all cells in the rectangle from min to max (inclusive), which is clipped to the field */
+  Sum sum(Vector min, Vector max) const {
+    min = Vector(std::max(min.x, 0), std::max(min.y, 0));
+    max = Vector(std::min(max.x, size.x - 1), std::min(max.y, size.y - 1));
+    if (min.x > max.x || min.y > max.y) {
+      return 0;
+    }
+    return prefix(max.x + 1, max.y + 1) - prefix(min.x, max.y + 1) - prefix(max.x + 1, min.y) + prefix(min.x, min.y);
+  }
+
+
+  Vector size;
+
+private:
+  size_t index(int x, int y) const { return static_cast<size_t>(y) * (size.x + 1) + x; }
+
+  /** Sum of all cells left of x and above y */
+  Sum prefix(int x, int y) const {
+    Sum result = 0;
+    for (int row = y; row > 0; row -= row & -row) {
+      for (int column = x; column > 0; column -= column & -column) {
+        result += tree[index(column, row)];
+      }
+    }
+    return result;
+  }
+
+  std::vector<Sum> tree;
+  std::vector<Sum> values; // the current cell values for set()
+};
+
+using FenwickTree2D = FenwickTree2DT<>;
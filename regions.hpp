@@ -0,0 +1,149 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "field.hpp"
+#include "parallel.hpp"
+
+/** Statistics of a connected region of equal cells
+ */
+template<typename T>
+struct RegionT {
+  /** Number of straight sides of the region's outline (including the outlines of holes), which equals the number of corners */
+  size_t sides() const { return corners; }
+
+  T value;
+  Vector first; // first cell of the region in row major order
+  Vector min, max; // inclusive bounding box
+  size_t area = 0;
+  size_t perimeter = 0; // number of cell edges, which border another region or the outside of the field
+  size_t corners = 0;
+};
+
+/** Result of findRegions(): labels[pos] is the index of the region containing pos
+ */
+template<typename T>
+struct RegionMapT {
+  FieldT<int> labels = FieldT<int>(0, 0, -1);
+  std::vector<RegionT<T>> regions;
+};
+
+
+namespace impl {
+  /** Union find over cell offsets, where the root of a set is always its smallest offset */
+  struct CellUnion {
+    int find(int cell) {
+      while (parent[cell] != cell) {
+        parent[cell] = parent[parent[cell]]; // path halving
+        cell = parent[cell];
+      }
+      return cell;
+    }
+
+    void unite(int a, int b) {
+      a = find(a);
+      b = find(b);
+      if (a != b) {
+        parent[std::max(a, b)] = std::min(a, b);
+      }
+    }
+
+    std::vector<int> parent;
+  };
+
+  /** Fields with fewer cells are labelled on the calling thread */
+  constexpr size_t MinParallelRegionCells = 1 << 16;
+}
+
+
+/** Labels the connected regions of equal cells (4-connected or 8-connected if diagonal is set) with a two pass union find.
+ *  The first pass unites each cell with its already visited equal neighbours in parallel row bands and then joins the
+ *  bands at their borders. The second pass assigns the labels in row major order of the regions' first cells and
+ *  collects area, perimeter, bounding box and corner count of all regions in the same scan.
+ */
+template<typename T>
+RegionMapT<T> findRegions(const FieldT<T>& field, bool diagonal = false, parallel::ThreadPool& pool = parallel::pool()) {
+  RegionMapT<T> result;
+  auto& size = field.size;
+  result.labels = FieldT<int>(size.x, size.y, -1);
+  if (size.x == 0 || size.y == 0) {
+    return result;
+  }
+
+  auto cell = [&](int x, int y) { return y * size.x + x; };
+  auto same = [&](const Vector& pos, const Vector& other) { return field.validPosition(other) && field[other] == field[pos]; };
+
+  impl::CellUnion cells;
+  cells.parent.resize(static_cast<size_t>(size.x) * size.y);
+  auto uniteRows = [&](int begin, int end) {
+    for (int y = begin; y < end; ++y) {
+      for (int x = 0; x < size.x; ++x) {
+        Vector pos(x, y);
+        cells.parent[cell(x, y)] = cell(x, y);
+        if (x > 0 && same(pos, Vector(x - 1, y))) {
+          cells.unite(cell(x, y), cell(x - 1, y));
+        }
+        if (y > begin) {
+          for (int dx = diagonal ? -1 : 0; dx <= (diagonal ? 1 : 0); ++dx) {
+            if (same(pos, Vector(x + dx, y - 1))) {
+              cells.unite(cell(x, y), cell(x + dx, y - 1));
+            }
+          }
+        }
+      }
+    }
+  };
+
+  // The bands only unite cells within their own rows, so they don't interfere
+  int bands = static_cast<size_t>(size.x) * size.y < impl::MinParallelRegionCells ? 1 : std::min<int>(pool.size(), size.y);
+  auto bandStart = [&](int band) { return band * size.y / bands; };
+  pool.forEach(bands, [&](size_t band, unsigned) {
+    uniteRows(bandStart(static_cast<int>(band)), bandStart(static_cast<int>(band) + 1));
+  });
+  for (int band = 1; band < bands; ++band) {
+    int y = bandStart(band);
+    for (int x = 0; x < size.x; ++x) {
+      for (int dx = diagonal ? -1 : 0; dx <= (diagonal ? 1 : 0); ++dx) {
+        if (same(Vector(x, y), Vector(x + dx, y - 1))) {
+          cells.unite(cell(x, y), cell(x + dx, y - 1));
+        }
+      }
+    }
+  }
+
+  // Second pass: the root is the first cell of each region, so it is always labelled before the other cells
+  for (int y = 0; y < size.y; ++y) {
+    for (int x = 0; x < size.x; ++x) {
+      Vector pos(x, y);
+      int root = cells.find(cell(x, y));
+      int label;
+      if (root == cell(x, y)) {
+        label = static_cast<int>(result.regions.size());
+        result.regions.push_back({ field[pos], pos, pos, pos });
+      } else {
+        label = result.labels[Vector(root % size.x, root / size.x)];
+      }
+      result.labels[pos] = label;
+
+      auto& region = result.regions[label];
+      ++region.area;
+      region.min = Vector(std::min(region.min.x, x), std::min(region.min.y, y));
+      region.max = Vector(std::max(region.max.x, x), std::max(region.max.y, y));
+
+      bool neighbours[4];
+      for (int side = 0; side < 4; ++side) {
+        neighbours[side] = same(pos, pos + Vector::AllSimpleDirections()[side]);
+        region.perimeter += !neighbours[side];
+      }
+      // Each pair of adjacent sides forms an outer corner if both are foreign or an inner corner if only the diagonal is foreign
+      for (int side = 0; side < 4; ++side) {
+        int nextSide = (side + 1) % 4;
+        auto diagonalPos = pos + Vector::AllSimpleDirections()[side] + Vector::AllSimpleDirections()[nextSide];
+        region.corners += (!neighbours[side] && !neighbours[nextSide]) ||
+                          (neighbours[side] && neighbours[nextSide] && !same(pos, diagonalPos));
+      }
+    }
+  }
+  return result;
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+/** Vectorized linear scans over contiguous element arrays (e.g. FieldT::data).
+ *  Elements of 1, 2 or 4 byte integral (or enum) types are compared a whole SSE2/AVX2 register at a time,
+ *  all other types and builds without SSE2 use the plain scalar loop.
+ */
+namespace scan {
+  namespace impl {
+#if defined(__AVX2__)
+    using Block = __m256i;
+    constexpr size_t BlockBytes = 32;
+
+    inline Block load(const void* data) { return _mm256_loadu_si256(static_cast<const Block*>(data)); }
+    inline uint32_t movemask(Block block) { return static_cast<uint32_t>(_mm256_movemask_epi8(block)); }
+
+    template<size_t Bytes>
+    Block broadcast(uint32_t value) {
+      if constexpr (Bytes == 1) return _mm256_set1_epi8(static_cast<char>(value));
+      else if constexpr (Bytes == 2) return _mm256_set1_epi16(static_cast<short>(value));
+      else return _mm256_set1_epi32(static_cast<int>(value));
+    }
+
+    template<size_t Bytes>
+    Block equal(Block a, Block b) {
+      if constexpr (Bytes == 1) return _mm256_cmpeq_epi8(a, b);
+      else if constexpr (Bytes == 2) return _mm256_cmpeq_epi16(a, b);
+      else return _mm256_cmpeq_epi32(a, b);
+    }
+#define SCAN_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    using Block = __m128i;
+    constexpr size_t BlockBytes = 16;
+
+    inline Block load(const void* data) { return _mm_loadu_si128(static_cast<const Block*>(data)); }
+    inline uint32_t movemask(Block block) { return static_cast<uint32_t>(_mm_movemask_epi8(block)); }
+
+    template<size_t Bytes>
+    Block broadcast(uint32_t value) {
+      if constexpr (Bytes == 1) return _mm_set1_epi8(static_cast<char>(value));
+      else if constexpr (Bytes == 2) return _mm_set1_epi16(static_cast<short>(value));
+      else return _mm_set1_epi32(static_cast<int>(value));
+    }
+
+    template<size_t Bytes>
+    Block equal(Block a, Block b) {
+      if constexpr (Bytes == 1) return _mm_cmpeq_epi8(a, b);
+      else if constexpr (Bytes == 2) return _mm_cmpeq_epi16(a, b);
+      else return _mm_cmpeq_epi32(a, b);
+    }
+#define SCAN_SIMD 1
+#else
+#define SCAN_SIMD 0
+#endif
+
+    template<typename T>
+    constexpr bool vectorizable = SCAN_SIMD && (std::is_integral_v<T> || std::is_enum_v<T>) && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+
+#if SCAN_SIMD
+    template<typename T>
+    Block broadcast(const T& value) {
+      uint32_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(T));
+      return broadcast<sizeof(T)>(bits);
+    }
+
+    /** Returns the byte mask of the elements in the block at data, which are equal to the broadcast needle.
+     *  Each matching element sets sizeof(T) consecutive bits.
+     */
+    template<typename T>
+    uint32_t matches(const T* data, Block needle) { return movemask(equal<sizeof(T)>(load(data), needle)); }
+
+    /** Calls fn(offset) for each element offset encoded in the byte mask of the block starting at base */
+    template<typename T, typename Callback>
+    void forEachBit(uint32_t mask, size_t base, Callback&& fn) {
+      while (mask != 0) {
+        auto bit = std::countr_zero(mask);
+        fn(base + bit / sizeof(T));
+        if constexpr (sizeof(T) == 1) {
+          mask &= mask - 1;
+        } else {
+          mask &= ~(((uint32_t(1) << sizeof(T)) - 1) << bit); // clear all bytes of this element
+        }
+      }
+    }
+#endif
+  }
+
+
+  /** Returns the number of elements in data equal to value */
+  template<typename T>
+  size_t count(std::span<const T> data, const T& value) {
+    size_t result = 0;
+    size_t offset = 0;
+#if SCAN_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      constexpr size_t Step = impl::BlockBytes / sizeof(T);
+      auto needle = impl::broadcast(value);
+      for (; offset + Step <= data.size(); offset += Step) {
+        result += std::popcount(impl::matches(data.data() + offset, needle));
+      }
+      result /= sizeof(T);
+    }
+#endif
+    for (; offset < data.size(); ++offset) {
+      result += data[offset] == value;
+    }
+    return result;
+  }
+
+  /** Calls fn(offset) in ascending order for each element in data equal to value */
+  template<typename T, typename Callback>
+  void forEachMatch(std::span<const T> data, const T& value, Callback&& fn) {
+    size_t offset = 0;
+#if SCAN_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      constexpr size_t Step = impl::BlockBytes / sizeof(T);
+      auto needle = impl::broadcast(value);
+      for (; offset + Step <= data.size(); offset += Step) {
+        impl::forEachBit<T>(impl::matches(data.data() + offset, needle), offset, fn);
+      }
+    }
+#endif
+    for (; offset < data.size(); ++offset) {
+      if (data[offset] == value) {
+        fn(offset);
+      }
+    }
+  }
+
+  /** Calls fn(offset, index) for each element in data, which is equal to values[index] with a single pass over the data.
+   *  The offsets are ascending for each index, but not across different indices.
+   */
+  template<typename T, typename Callback>
+  void forEachMatch(std::span<const T> data, std::span<const T> values, Callback&& fn) {
+    size_t offset = 0;
+#if SCAN_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      constexpr size_t Step = impl::BlockBytes / sizeof(T);
+      constexpr size_t MaxNeedles = 16;
+      impl::Block needles[MaxNeedles];
+      if (values.size() <= MaxNeedles) {
+        for (size_t index = 0; index < values.size(); ++index) {
+          needles[index] = impl::broadcast(values[index]);
+        }
+        for (; offset + Step <= data.size(); offset += Step) {
+          for (size_t index = 0; index < values.size(); ++index) {
+            impl::forEachBit<T>(impl::matches(data.data() + offset, needles[index]), offset, [&](size_t match) { fn(match, index); });
+          }
+        }
+      }
+    }
+#endif
+    for (; offset < data.size(); ++offset) {
+      for (size_t index = 0; index < values.size(); ++index) {
+        if (data[offset] == values[index]) {
+          fn(offset, index);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <bit>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <cassert>
+#include <cstdint>
+#include <ranges>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <memory_resource>
+
+/** Monotone bucket queue (Dial's algorithm) for small non negative integer priorities.
+ *  The buckets are arranged in a ring, which is indexed by priority modulo the number of buckets. Pushed priorities
+ *  must never be lower than the last popped priority, which holds for Dijkstra with non negative edge costs.
+ *  If a priority is pushed, which lies further ahead than the ring can hold, the ring is grown automatically.
+ */
+template<typename Value>
+struct BucketQueue {
+  BucketQueue(int maxEdgeCost = 1) : buckets(std::bit_ceil(static_cast<size_t>(maxEdgeCost) + 1)) {}
+
+  void push(int priority, const Value& value) {
+    assert(priority >= current); // monotonicity is required
+    if (static_cast<size_t>(priority - current) >= buckets.size()) {
+      grow(priority - current + 1);
+    }
+    buckets[priority & mask()].push_back(value);
+    ++count;
+  }
+
+  /** Removes and returns one of the entries with the lowest priority (queue must not be empty)
+   */
+  std::pair<int, Value> pop() {
+    assert(count > 0);
+    while (buckets[current & mask()].empty()) {
+      ++current;
+    }
+    auto& bucket = buckets[current & mask()];
+    std::pair<int, Value> result(current, bucket.back());
+    bucket.pop_back();
+    --count;
+    return result;
+  }
+
+  bool empty() const { return count == 0; }
+  size_t size() const { return count; }
+
+  /** Makes room for priorities up to maxEdgeCost ahead of the current one without growing later
+   */
+  void reserve(int maxEdgeCost) {
+    if (static_cast<size_t>(maxEdgeCost) >= buckets.size()) {
+      grow(maxEdgeCost + 1);
+    }
+  }
+
+  /** Removes all entries, but keeps the allocated bucket storage for reuse
+   */
+  void clear() {
+    for (auto& bucket : buckets) {
+      bucket.clear();
+    }
+    current = 0;
+    count = 0;
+  }
+
+  std::vector<std::vector<Value>> buckets;
+  int current = 0; // lowest priority, which may still be contained in the queue
+  size_t count = 0;
+
+private:
+  size_t mask() const { return buckets.size() - 1; }
+
+  void grow(int range) {
+    std::vector<std::vector<Value>> newBuckets(std::bit_ceil(static_cast<size_t>(range)));
+    // Each old bucket holds exactly one priority in [current, current + buckets.size())
+    for (int priority = current; priority < current + static_cast<int>(buckets.size()); ++priority) {
+      newBuckets[priority & (newBuckets.size() - 1)] = std::move(buckets[priority & mask()]);
+    }
+    buckets = std::move(newBuckets);
+  }
+};
+
+
+namespace search {
+  /** Default heuristic for SearchT::findPathAStar(), which turns A* into Dijkstra's algorithm
+   */
+  struct NoHeuristic {
+    template<typename State>
+    int operator()(const State&) const { return 0; }
+  };
+
+  /** Goal predicate, which never matches and thus makes a search expand all reachable states
+   */
+  struct NoGoal {
+    template<typename State>
+    bool operator()(const State&) const { return false; }
+  };
+}
+
+
+/** Reusable storage for SearchT: the frontier, cost table and predecessor tables.
+ *  Resetting is O(1): each cost entry is tagged with the generation it was written in and entries of older generations
+ *  read as Unreachable, so the tables are never cleared. Pass one workspace to many short lived searches to avoid
+ *  allocating and freeing their tables over and over again. Only the results of the search, which ran last in the
+ *  workspace, are available: the searches sharing it remember the generation of their last run and report all states
+ *  as Unreachable once another search has reset the workspace.
+ */
+struct SearchWorkspace {
+  static constexpr int Unreachable = std::numeric_limits<int>::max();
+
+  struct PredecessorLink {
+    int index, next;
+  };
+
+  /** Invalidates all costs and prepares the tables for the given number of states. This also releases the memory
+   *  handed out by memory(), so any containers using it must have been destroyed before.
+   */
+  void reset(size_t stateCount) {
+    if (generations.size() < stateCount) {
+      costs.resize(stateCount);
+      predecessors.resize(stateCount);
+      equalPredecessors.resize(stateCount);
+      generations.resize(stateCount, 0);
+    }
+    if (++generation == 0) {
+      // The generation counter wrapped around, so old tags could become valid again
+      std::ranges::fill(generations, 0);
+      generation = 1;
+    }
+    predecessorLinks.clear();
+    expansionOrder.clear();
+    expandQueue.clear();
+    arena.release();
+  }
+
+  bool reached(int index) const { return static_cast<size_t>(index) < generations.size() && generations[index] == generation; }
+  int cost(int index) const { return reached(index) ? costs[index] : Unreachable; }
+
+  void setCost(int index, int cost) {
+    costs[index] = cost;
+    generations[index] = generation;
+  }
+
+  /** Arena for node based containers (e.g. std::pmr::set), which is released on each reset()
+   */
+  std::pmr::memory_resource* memory() { return &arena; }
+
+
+  std::vector<int> costs; // only valid for reached() indices
+  std::vector<int> predecessors; // index of the previous state on the cheapest path or -1 for start states
+  std::vector<uint32_t> generations;
+  uint32_t generation = 0;
+
+  // Further predecessors with equal costs are kept as linked lists in a flat pool, which is only appended to
+  std::vector<int> equalPredecessors; // head into predecessorLinks or -1
+  std::vector<PredecessorLink> predecessorLinks;
+  std::vector<int> expansionOrder; // state indices in the order they were expanded
+
+  BucketQueue<int> expandQueue;
+  std::pmr::monotonic_buffer_resource arena;
+};
+
+
+/** Generic shortest path search (Dijkstra/A*) over an arbitrary state type.
+ *  The state space is described by three callables:
+ *   - encode(state) -> int: maps each state to a unique index in [0, stateCount), e.g. offset * 4 + direction
+ *   - decode(index) -> State: the inverse of encode()
+ *   - expand(state, emit): calls emit(nextState, stepCost) for each successor with a non negative step cost
+ *  Because each state has a compact index, costs and predecessors are kept in flat arrays and the frontier
+ *  is a bucket queue over small integer costs. These tables live in a SearchWorkspace, which is either owned by
+ *  the search or passed in to share it between many searches.
+ */
+template<typename Encode, typename Decode, typename Expand>
+struct SearchT {
+  using State = std::remove_cvref_t<std::invoke_result_t<Decode, int>>;
+  static constexpr int Unreachable = SearchWorkspace::Unreachable;
+
+  SearchT(size_t stateCount, Encode encode, Decode decode, Expand expand, int maxStepCost = 1, SearchWorkspace* workspace = nullptr) :
+    stateCount(stateCount), encode(std::move(encode)), decode(std::move(decode)), expand(std::move(expand)),
+    ownWorkspace(workspace ? nullptr : std::make_unique<SearchWorkspace>()), workspace(workspace ? workspace : ownWorkspace.get()) {
+    this->workspace->expandQueue.reserve(maxStepCost);
+  }
+
+  /** Runs all following searches in the given workspace, which must outlive this search
+   */
+  void use(SearchWorkspace& workspace) {
+    this->workspace = &workspace;
+    ownWorkspace.reset();
+    generation = 0; // the results of the last search are gone with the old workspace
+  }
+
+
+  /** Calculates the cheapest path from start to the first state satisfying isGoal(state) and returns its costs
+   *  (or -1 if no goal is reachable). With expandAllStates the search continues until all reachable states are expanded.
+   */
+  template<typename Goal>
+  int findPath(const State& start, Goal isGoal, bool expandAllStates = false) {
+    return run(std::ranges::single_view(start), isGoal, search::NoHeuristic(), expandAllStates);
+  }
+
+  /** Same as findPath(), but starts from all given states at cost 0
+   */
+  template<std::ranges::input_range Starts, typename Goal>
+  int findPath(Starts&& starts, Goal isGoal, bool expandAllStates = false) {
+    return run(std::forward<Starts>(starts), isGoal, search::NoHeuristic(), expandAllStates);
+  }
+
+  /** Same as findPath(), but expands the states in the order of their cost plus heuristic(state), which must be a
+   *  consistent estimate (never overestimating) of the remaining costs to the goal.
+   */
+  template<typename Goal, typename Heuristic>
+  int findPathAStar(const State& start, Goal isGoal, Heuristic heuristic) {
+    return run(std::ranges::single_view(start), isGoal, heuristic, false);
+  }
+
+  /** Expands all states reachable from start, so that getCost() returns the costs to each state
+   */
+  void expandAll(const State& start) {
+    findPath(start, search::NoGoal(), true);
+  }
+
+  /** Invalidates the results of the last search
+   */
+  void reset() {
+    workspace->reset(stateCount);
+    generation = workspace->generation;
+    expandedNodes = 0;
+    goal = -1;
+  }
+
+
+  /** Returns the cost of the cheapest known path to the given state (or Unreachable, also if another search
+   *  has run in the shared workspace since)
+   */
+  int getCost(const State& state) const {
+    return generation == workspace->generation ? workspace->cost(encode(state)) : Unreachable;
+  }
+
+  /** Returns the cheapest path from a start state to the given target (inclusive) or an empty vector if the target
+   *  was not reached by the last search.
+   */
+  std::vector<State> getPath(const State& target) const {
+    std::vector<State> path;
+    if (getCost(target) == Unreachable) {
+      return path;
+    }
+
+    for (int index = encode(target); index != -1; index = workspace->predecessors[index]) {
+      path.push_back(decode(index));
+    }
+    std::ranges::reverse(path);
+    return path;
+  }
+
+  /** Returns the cheapest path to the goal, which has been found by the last search
+   */
+  std::vector<State> getCheapestPath() const {
+    return goal != -1 && generation == workspace->generation ? getPath(decode(goal)) : std::vector<State>();
+  }
+
+
+  /** Calls fn(predecessorIndex) for each predecessor of the state index in the DAG of all cheapest paths.
+   *  The DAG is complete for expanded states if all step costs are positive and no heuristic was used.
+   *  The index must have been reached by the last search in the workspace (getCost() != Unreachable).
+   */
+  template<typename Fn>
+  void forEachPredecessor(int index, Fn&& fn) const {
+    if (workspace->predecessors[index] == -1) {
+      return; // start state
+    }
+    fn(workspace->predecessors[index]);
+    for (int link = workspace->equalPredecessors[index]; link != -1; link = workspace->predecessorLinks[link].next) {
+      fn(workspace->predecessorLinks[link].index);
+    }
+  }
+
+  /** Returns the number of distinct cheapest paths from the start states to target modulo 2^64
+   */
+  uint64_t countCheapestPaths(const State& target) const {
+    if (getCost(target) == Unreachable) {
+      return 0;
+    }
+
+    // Predecessors are expanded before their successors, so a single pass in expansion order suffices
+    std::vector<uint64_t> pathCounts(stateCount, 0);
+    for (int index : workspace->expansionOrder) {
+      if (workspace->predecessors[index] == -1) {
+        pathCounts[index] = 1;
+      } else {
+        forEachPredecessor(index, [&](int predecessor) { pathCounts[index] += pathCounts[predecessor]; });
+      }
+    }
+    return pathCounts[encode(target)];
+  }
+
+  /** Returns a flag for each state index, which is set if the state lies on any cheapest path to target
+   */
+  std::vector<bool> onCheapestPaths(const State& target) const {
+    std::vector<bool> marked(stateCount, false);
+    if (getCost(target) == Unreachable) {
+      return marked;
+    }
+
+    std::vector<int> pending = { encode(target) };
+    marked[pending.back()] = true;
+    while (!pending.empty()) {
+      int index = pending.back();
+      pending.pop_back();
+      forEachPredecessor(index, [&](int predecessor) {
+        if (!marked[predecessor]) {
+          marked[predecessor] = true;
+          pending.push_back(predecessor);
+        }
+      });
+    }
+    return marked;
+  }
+
+
+  size_t stateCount;
+  Encode encode;
+  Decode decode;
+  Expand expand;
+
+  std::unique_ptr<SearchWorkspace> ownWorkspace; // only used if no workspace was passed in
+  SearchWorkspace* workspace;
+  uint32_t generation = 0; // workspace generation of the last search, which is 0 before the first search
+  int goal = -1; // index of the goal found by the last search
+  size_t expandedNodes = 0; // number of states expanded by the last search
+
+private:
+  template<typename Starts, typename Goal, typename Heuristic>
+  int run(Starts&& starts, Goal& isGoal, Heuristic heuristic, bool expandAllStates) {
+    reset();
+    auto& ws = *workspace;
+
+    for (const State& start : starts) {
+      auto index = encode(start);
+      if (ws.reached(index)) {
+        continue; // the same start state was passed twice
+      }
+      ws.setCost(index, 0);
+      ws.predecessors[index] = -1;
+      ws.expandQueue.push(heuristic(start), index);
+    }
+
+    int pathCost = -1;
+    while (!ws.expandQueue.empty()) {
+      auto [priority, index] = ws.expandQueue.pop();
+      int cost = ws.costs[index];
+      State state = decode(index);
+
+      if (priority != cost + heuristic(state)) {
+        // Do not expand this entry, because we have found a cheaper path to this state after it was queued
+        continue;
+      }
+
+      ++expandedNodes;
+      ws.expansionOrder.push_back(index);
+      if (goal == -1 && isGoal(state)) {
+        goal = index;
+        pathCost = cost;
+        if (!expandAllStates) {
+          return cost;
+        }
+      }
+
+      expand(state, [&](const State& nextState, int stepCost) {
+        auto nextIndex = encode(nextState);
+        auto nextCost = ws.cost(nextIndex);
+        if (cost + stepCost < nextCost) {
+          ws.setCost(nextIndex, cost + stepCost);
+          ws.predecessors[nextIndex] = index;
+          ws.equalPredecessors[nextIndex] = -1;
+          ws.expandQueue.push(cost + stepCost + heuristic(nextState), nextIndex);
+        } else if (cost + stepCost == nextCost && ws.predecessors[nextIndex] != -1) {
+          // Another cheapest path (start states have no predecessors)
+          ws.predecessorLinks.push_back({ index, ws.equalPredecessors[nextIndex] });
+          ws.equalPredecessors[nextIndex] = static_cast<int>(ws.predecessorLinks.size()) - 1;
+        }
+      });
+    }
+
+    return pathCost;
+  }
+};
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <iterator>
+#include <type_traits>
+
+#include "field.hpp"
+#include "flathash.hpp"
+
+/** Unbounded two dimensional field for coordinates, which grow in any direction (infinite maps, walkers, growing simulations).
+ *  The cells are stored in dense chunks of ChunkSize x ChunkSize cells, which are allocated on the first write and found
+ *  through a flat hash map keyed by the chunk coordinate. Cells of unallocated chunks read as the fill value.
+ *  The last chunk used by a non const access is cached, so accessing neighbouring cells within the same chunk skips the hash lookup.
+ *  Const accesses use but never update that cache, so a field, which is not modified meanwhile, can be read from several threads.
+ */
+template<typename Element, int ChunkBits = 6>
+struct SparseFieldT {
+  static constexpr int ChunkSize = 1 << ChunkBits;
+  static constexpr int ChunkMask = ChunkSize - 1;
+
+  struct Chunk {
+    Chunk(const Vector& origin, const Element& fill) : origin(origin) { cells.fill(fill); }
+
+    Element& operator[](const Vector& pos) { return cells[(pos.y & ChunkMask) * ChunkSize + (pos.x & ChunkMask)]; }
+    const Element& operator[](const Vector& pos) const { return cells[(pos.y & ChunkMask) * ChunkSize + (pos.x & ChunkMask)]; }
+
+    Vector origin; // position of the top left cell
+    std::array<Element, ChunkSize * ChunkSize> cells;
+  };
+
+
+  /** Forward iterator over all cells of the allocated chunks in allocation order (including cells with the fill value) */
+  template<typename ChunkPointer, typename Value>
+  struct CellIterator {
+    using value_type = std::remove_const_t<Value>;
+    using reference = Value&;
+    using pointer = Value*;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+
+    CellIterator() = default;
+    CellIterator(ChunkPointer chunk, int cell) : chunk(chunk), cell(cell) {}
+
+    bool operator==(const CellIterator& other) const { return chunk == other.chunk && cell == other.cell; }
+
+    CellIterator& operator++() {
+      if (++cell == ChunkSize * ChunkSize) {
+        ++chunk;
+        cell = 0;
+      }
+      return *this;
+    }
+    CellIterator operator++(int) { auto copy = *this; ++(*this); return copy; }
+    Value& operator*() const { return (*chunk)->cells[cell]; }
+
+    /** Returns the position of the current cell */
+    Vector pos() const { return (*chunk)->origin + Vector(cell & ChunkMask, cell >> ChunkBits); }
+
+    ChunkPointer chunk = nullptr;
+    int cell = 0;
+  };
+
+  using iterator = CellIterator<typename std::vector<std::unique_ptr<Chunk>>::const_pointer, Element>;
+  using const_iterator = CellIterator<typename std::vector<std::unique_ptr<Chunk>>::const_pointer, const Element>;
+
+
+  SparseFieldT(Element fill = Element{}) : fill(fill) {}
+
+  SparseFieldT(const SparseFieldT& other) : fill(other.fill), chunkIndex(other.chunkIndex) {
+    for (auto& chunk : other.chunks) {
+      chunks.push_back(std::make_unique<Chunk>(*chunk));
+    }
+  }
+
+  // The moved from field must not keep its cached chunk, which now belongs to the other field
+  SparseFieldT(SparseFieldT&& other) noexcept : fill(other.fill), chunks(std::move(other.chunks)), chunkIndex(std::move(other.chunkIndex)),
+                                                lastKey(other.lastKey), lastChunk(other.lastChunk) {
+    other.clear();
+  }
+
+  SparseFieldT& operator=(SparseFieldT&& other) noexcept {
+    if (this != &other) {
+      fill = other.fill;
+      chunks = std::move(other.chunks);
+      chunkIndex = std::move(other.chunkIndex);
+      lastKey = other.lastKey;
+      lastChunk = other.lastChunk;
+      other.clear();
+    }
+    return *this;
+  }
+  SparseFieldT& operator=(const SparseFieldT& other) { return *this = SparseFieldT(other); }
+
+  /** Copies the field into the sparse field with its top left corner at origin */
+  SparseFieldT(const FieldT<Element>& field, Element fill = Element{}, const Vector& origin = Vector(0, 0)) : fill(fill) {
+    for (int y = 0; y < field.size.y; ++y) {
+      for (int x = 0; x < field.size.x; ++x) {
+        (*this)[origin + Vector(x, y)] = field[Vector(x, y)];
+      }
+    }
+  }
+
+  /** Returns the cell at pos and allocates its chunk if necessary */
+  Element& operator[](const Vector& pos) {
+    auto chunk = findChunk(pos);
+    return chunk ? (*chunk)[pos] : (*allocate(pos))[pos];
+  }
+
+  /** Returns the cell at pos or the fill value if its chunk is not allocated */
+  const Element& operator[](const Vector& pos) const {
+    auto chunk = findChunk(pos);
+    return chunk ? (*chunk)[pos] : fill;
+  }
+
+  bool isAt(const Element& element, const Vector& pos) const { return (*this)[pos] == element; }
+  /** checked field access, which returns a copy to the value if the chunk of the position has been allocated */
+  std::optional<Element> at(const Vector& pos) const {
+    auto chunk = findChunk(pos);
+    return chunk ? std::optional<Element>((*chunk)[pos]) : std::nullopt;
+  }
+  Element at(const Vector& pos, Element defaultValue) const {
+    auto chunk = findChunk(pos);
+    return chunk ? (*chunk)[pos] : defaultValue;
+  }
+  bool isAllocated(const Vector& pos) const { return findChunk(pos) != nullptr; }
+
+
+  iterator begin() { return iterator(chunks.data(), 0); }
+  iterator end() { return iterator(chunks.data() + chunks.size(), 0); }
+  const_iterator begin() const { return const_iterator(chunks.data(), 0); }
+  const_iterator end() const { return const_iterator(chunks.data() + chunks.size(), 0); }
+
+  /** Calls fn(pos, value) for each cell of the allocated chunks (including cells with the fill value) */
+  template<typename Fn>
+  void forEach(Fn&& fn) {
+    for (auto& chunk : chunks) {
+      forEachCell(*chunk, fn);
+    }
+  }
+
+  template<typename Fn>
+  void forEach(Fn&& fn) const {
+    for (auto& chunk : chunks) {
+      forEachCell(static_cast<const Chunk&>(*chunk), fn);
+    }
+  }
+
+  /** Returns the number of cells equal to element within the allocated chunks */
+  size_t count(const Element& element) const {
+    size_t result = 0;
+    for (auto& chunk : chunks) {
+      result += scan::count(std::span<const Element>(chunk->cells), element);
+    }
+    return result;
+  }
+
+  /** Returns the smallest and largest position of all cells, which differ from the fill value or
+   *  (Vector(0, 0), Vector(-1, -1)) if there are no such cells
+   */
+  std::pair<Vector, Vector> bounds() const {
+    Vector min(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+    Vector max(std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
+    forEach([&](const Vector& pos, const Element& value) {
+      if (value != fill) {
+        min = Vector(std::min(min.x, pos.x), std::min(min.y, pos.y));
+        max = Vector(std::max(max.x, pos.x), std::max(max.y, pos.y));
+      }
+    });
+    return min.x <= max.x ? std::make_pair(min, max) : std::make_pair(Vector(0, 0), Vector(-1, -1));
+  }
+
+  /** Copies the cells from min to max (inclusive) into a dense field, where min becomes Vector(0, 0) */
+  FieldT<Element> toField(const Vector& min, const Vector& max) const {
+    FieldT<Element> field(max.x - min.x + 1, max.y - min.y + 1, fill);
+    for (int y = 0; y < field.size.y; ++y) {
+      for (int x = 0; x < field.size.x; ++x) {
+        field[Vector(x, y)] = (*this)[min + Vector(x, y)];
+      }
+    }
+    return field;
+  }
+
+  /** Copies the bounding box of all non fill cells into a dense field (its top left corner is bounds().first) */
+  FieldT<Element> toField() const {
+    auto [min, max] = bounds();
+    return toField(min, max);
+  }
+
+  size_t chunkCount() const { return chunks.size(); }
+
+  void clear() {
+    chunks.clear();
+    chunkIndex.clear();
+    lastChunk = nullptr;
+  }
+
+
+  Element fill;
+
+private:
+  static Vector chunkOf(const Vector& pos) { return Vector(pos.x >> ChunkBits, pos.y >> ChunkBits); } // rounds towards -infinity
+
+  // Const lookups leave the cache untouched, so concurrent readers don't write shared state
+  const Chunk* findChunk(const Vector& pos) const {
+    auto key = chunkOf(pos);
+    if (lastChunk && lastKey == key) {
+      return lastChunk;
+    }
+    auto entry = chunkIndex.find(key);
+    return entry != chunkIndex.end() ? chunks[entry->second].get() : nullptr;
+  }
+
+  Chunk* findChunk(const Vector& pos) {
+    auto key = chunkOf(pos);
+    if (lastChunk && lastKey == key) {
+      return lastChunk;
+    }
+    auto entry = chunkIndex.find(key);
+    if (entry == chunkIndex.end()) {
+      return nullptr;
+    }
+    lastKey = key;
+    lastChunk = chunks[entry->second].get();
+    return lastChunk;
+  }
+
+  Chunk* allocate(const Vector& pos) {
+    auto key = chunkOf(pos);
+    chunkIndex.emplace(key, chunks.size());
+    chunks.push_back(std::make_unique<Chunk>(Vector(key.x * ChunkSize, key.y * ChunkSize), fill));
+    lastKey = key;
+    lastChunk = chunks.back().get();
+    return lastChunk;
+  }
+
+  template<typename ChunkType, typename Fn>
+  static void forEachCell(ChunkType& chunk, Fn& fn) {
+    for (int y = 0; y < ChunkSize; ++y) {
+      for (int x = 0; x < ChunkSize; ++x) {
+        fn(chunk.origin + Vector(x, y), chunk.cells[y * ChunkSize + x]);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Chunk>> chunks;
+  FlatHashMap<Vector, size_t> chunkIndex; // chunk coordinate -> index into chunks
+
+  // Cache of the last chunk accessed by a non const access to skip the hash lookup for neighbouring cells
+  Vector lastKey;
+  Chunk* lastChunk = nullptr;
+};
+
+using SparseField = SparseFieldT<char>;
@@ -0,0 +1,584 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <queue>
+#include <tuple>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "flathash.hpp"
+
+// Only declared, so that this header works with vector.hpp as well as with vector3d.hpp
+template<typename T>
+struct VectorT;
+template<typename T>
+struct VectorT3D;
+
+/** Spatial indexes over 2D and 3D point clouds (VectorT or VectorT3D), which answer nearest neighbour and radius queries and
+ *  stream the closest pairs of points without looking at all n^2 pairs.
+ *  All distances are squared euclidean distances, which avoids the square root and orders the same way.
+ *  Points are referred to by their index in the order in which they were passed to the index.
+ */
+namespace spatial {
+  namespace impl {
+    template<typename Point>
+    struct PointTraits;
+
+    template<typename T>
+    struct PointTraits<VectorT<T>> {
+      using Coordinate = T;
+      static constexpr int Dims = 2;
+      static T get(const VectorT<T>& point, int axis) { return axis == 0 ? point.x : point.y; }
+      static VectorT<T> make(const std::array<T, 2>& coordinates) { return VectorT<T>(coordinates[0], coordinates[1]); }
+    };
+
+    template<typename T>
+    struct PointTraits<VectorT3D<T>> {
+      using Coordinate = T;
+      static constexpr int Dims = 3;
+      static T get(const VectorT3D<T>& point, int axis) { return axis == 0 ? point.x : (axis == 1 ? point.y : point.z); }
+      static VectorT3D<T> make(const std::array<T, 3>& coordinates) { return VectorT3D<T>(coordinates[0], coordinates[1], coordinates[2]); }
+    };
+  }
+
+  /** Type of the squared distances, which is wide enough for the squares of 32 bit coordinates */
+  template<typename Point>
+  using Distance = std::conditional_t<std::is_floating_point_v<typename impl::PointTraits<Point>::Coordinate>, double, int64_t>;
+
+  template<typename Point>
+  Distance<Point> squaredDistance(const Point& a, const Point& b) {
+    using Traits = impl::PointTraits<Point>;
+    Distance<Point> result = 0;
+    for (int axis = 0; axis < Traits::Dims; ++axis) {
+      auto delta = static_cast<Distance<Point>>(Traits::get(a, axis)) - static_cast<Distance<Point>>(Traits::get(b, axis));
+      result += delta * delta;
+    }
+    return result;
+  }
+
+  /** Result of a neighbour query. Neighbours are ordered by their distance and ties by their index. */
+  template<typename Distance>
+  struct NeighbourT {
+    int index;
+    Distance distance;
+
+    bool operator==(const NeighbourT& other) const = default;
+    bool operator<(const NeighbourT& other) const { return distance < other.distance || (distance == other.distance && index < other.index); }
+  };
+
+  /** Pair of points with first < second */
+  template<typename Distance>
+  struct PointPairT {
+    int first, second;
+    Distance distance;
+
+    bool operator==(const PointPairT& other) const = default;
+  };
+
+  namespace impl {
+    /** Bounded max heap, which keeps the count smallest neighbours seen so far */
+    template<typename Distance>
+    struct NearestHeap {
+      using Neighbour = NeighbourT<Distance>;
+
+      NearestHeap(int count) : count(count) {
+        if (count > 0) {
+          heap.reserve(count);
+        }
+      }
+
+      bool full() const { return static_cast<int>(heap.size()) >= count; }
+
+      /** Neighbours further away than this can't be part of the result anymore */
+      Distance bound() const { return full() ? heap.front().distance : std::numeric_limits<Distance>::max(); }
+
+      void add(int index, Distance distance) {
+        Neighbour neighbour{ index, distance };
+        if (!full()) {
+          heap.push_back(neighbour);
+          std::push_heap(heap.begin(), heap.end());
+        } else if (neighbour < heap.front()) {
+          std::pop_heap(heap.begin(), heap.end());
+          heap.back() = neighbour;
+          std::push_heap(heap.begin(), heap.end());
+        }
+      }
+
+      std::vector<Neighbour> sorted() {
+        std::sort_heap(heap.begin(), heap.end());
+        return std::move(heap);
+      }
+
+      int count;
+      std::vector<Neighbour> heap;
+    };
+  }
+
+
+  /** Lazily enumerates all pairs of points of a spatial index ordered by their distance (ties by their indices).
+   *  Each point keeps a batch of its nearest neighbours, which is fetched again with twice the size once it is used up,
+   *  and a heap over the next unused neighbour of each point yields the next pair. Taking the k closest pairs therefore
+   *  only queries O(n + k) neighbours instead of computing all n^2 distances.
+   *  Index must provide size(), operator[](index) and nearest(point, count).
+   */
+  template<typename Index>
+  struct ClosestPairs {
+    using Point = std::remove_cvref_t<decltype(std::declval<const Index&>()[0])>;
+    using Distance = spatial::Distance<Point>;
+    using PointPair = PointPairT<Distance>;
+
+    explicit ClosestPairs(const Index& index) : index(index), streams(index.size()) {
+      for (int point = 0; point < static_cast<int>(streams.size()); ++point) {
+        advance(point);
+      }
+    }
+
+    /** Returns the next closest pair or nullopt after all pairs have been returned */
+    std::optional<PointPair> next() {
+      while (!candidates.empty()) {
+        Candidate candidate = candidates.top();
+        candidates.pop();
+        advance(candidate.owner);
+        // Each pair is found from both of its points. The copies have the same key, so they are popped one after the other.
+        if (last && last->first == candidate.pair.first && last->second == candidate.pair.second) {
+          continue;
+        }
+        last = candidate.pair;
+        return candidate.pair;
+      }
+      return std::nullopt;
+    }
+
+  private:
+    static constexpr int FirstBatch = 4;
+
+    struct Candidate {
+      PointPair pair;
+      int owner;
+
+      bool operator>(const Candidate& other) const {
+        return std::tie(pair.distance, pair.first, pair.second) > std::tie(other.pair.distance, other.pair.first, other.pair.second);
+      }
+    };
+
+    struct Stream {
+      std::vector<NeighbourT<Distance>> neighbours; // without the point itself
+      int used = 0;
+      bool exhausted = false;
+    };
+
+    /** Pushes the next unused neighbour of the point as a candidate */
+    void advance(int point) {
+      Stream& stream = streams[point];
+      if (stream.used == static_cast<int>(stream.neighbours.size())) {
+        if (stream.exhausted) {
+          return;
+        }
+        // Neighbours are ordered by (distance, index), so the larger batch starts with the neighbours already used
+        int count = std::max(FirstBatch, stream.used * 2) + 1;
+        stream.neighbours = index.nearest(index[point], count);
+        stream.exhausted = static_cast<int>(stream.neighbours.size()) < count;
+        std::erase_if(stream.neighbours, [&](const auto& neighbour) { return neighbour.index == point; });
+        if (stream.used == static_cast<int>(stream.neighbours.size())) {
+          stream.exhausted = true;
+          return;
+        }
+      }
+      const auto& neighbour = stream.neighbours[stream.used++];
+      candidates.push(Candidate{ PointPair{ std::min(point, neighbour.index), std::max(point, neighbour.index), neighbour.distance }, point });
+    }
+
+    const Index& index;
+    std::vector<Stream> streams;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    std::optional<PointPair> last;
+  };
+}
+
+
+/** k-d tree, which is built once in bulk from a set of points.
+ *  The points are stored in tree order and each node splits its range at the median of the axis with the largest extent,
+ *  so queries take O(log n) for evenly spread points. Small ranges are searched linearly.
+ */
+template<typename Point>
+struct KdTreeT {
+  using Traits = spatial::impl::PointTraits<Point>;
+  using Distance = spatial::Distance<Point>;
+  using Neighbour = spatial::NeighbourT<Distance>;
+
+  KdTreeT() = default;
+  explicit KdTreeT(std::vector<Point> points) : points(std::move(points)) {
+    entries.reserve(this->points.size());
+    for (int index = 0; index < static_cast<int>(this->points.size()); ++index) {
+      entries.push_back(Entry{ this->points[index], index });
+    }
+    axes.assign(entries.size(), 0);
+    build(0, static_cast<int>(entries.size()));
+  }
+
+  size_t size() const { return points.size(); }
+  const Point& operator[](int index) const { return points[index]; }
+
+  /** Returns the count nearest points to query ordered by their distance */
+  std::vector<Neighbour> nearest(const Point& query, int count) const {
+    spatial::impl::NearestHeap<Distance> heap(count);
+    if (count > 0) {
+      searchNearest(0, static_cast<int>(entries.size()), query, heap);
+    }
+    return heap.sorted();
+  }
+
+  /** Calls fn(Neighbour) for each point within the (squared) radius around query in no particular order */
+  template<typename Fn>
+  void forEachWithin(const Point& query, Distance squaredRadius, Fn&& fn) const {
+    searchWithin(0, static_cast<int>(entries.size()), query, squaredRadius, fn);
+  }
+
+  /** Returns all points within the (squared) radius around query ordered by their distance */
+  std::vector<Neighbour> within(const Point& query, Distance squaredRadius) const {
+    std::vector<Neighbour> result;
+    forEachWithin(query, squaredRadius, [&](const Neighbour& neighbour) { result.push_back(neighbour); });
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  /** Enumerates all pairs of points ordered by their distance, see spatial::ClosestPairs */
+  spatial::ClosestPairs<KdTreeT> closestPairs() const { return spatial::ClosestPairs<KdTreeT>(*this); }
+
+private:
+  static constexpr int LeafSize = 8;
+
+  struct Entry {
+    Point point;
+    int index;
+  };
+
+  static Distance coordinate(const Point& point, int axis) { return static_cast<Distance>(Traits::get(point, axis)); }
+
+  void build(int begin, int end) {
+    if (end - begin <= LeafSize) {
+      return;
+    }
+    int axis = 0;
+    Distance widest = -1;
+    for (int dim = 0; dim < Traits::Dims; ++dim) {
+      auto [min, max] = std::minmax_element(entries.begin() + begin, entries.begin() + end, [&](const Entry& a, const Entry& b) {
+        return Traits::get(a.point, dim) < Traits::get(b.point, dim);
+      });
+      Distance extent = coordinate(max->point, dim) - coordinate(min->point, dim);
+      if (extent > widest) {
+        widest = extent;
+        axis = dim;
+      }
+    }
+
+    int middle = begin + (end - begin) / 2;
+    std::nth_element(entries.begin() + begin, entries.begin() + middle, entries.begin() + end, [&](const Entry& a, const Entry& b) {
+      return Traits::get(a.point, axis) < Traits::get(b.point, axis);
+    });
+    axes[middle] = static_cast<uint8_t>(axis);
+    build(begin, middle);
+    build(middle + 1, end);
+  }
+
+  void searchNearest(int begin, int end, const Point& query, spatial::impl::NearestHeap<Distance>& heap) const {
+    if (end - begin <= LeafSize) {
+      for (int entry = begin; entry < end; ++entry) {
+        heap.add(entries[entry].index, spatial::squaredDistance(query, entries[entry].point));
+      }
+      return;
+    }
+    int middle = begin + (end - begin) / 2;
+    const Entry& split = entries[middle];
+    Distance delta = coordinate(query, axes[middle]) - coordinate(split.point, axes[middle]);
+    heap.add(split.index, spatial::squaredDistance(query, split.point));
+
+    // Descend into the side of the query first, which usually makes the other side unnecessary
+    if (delta < 0) {
+      searchNearest(begin, middle, query, heap);
+      if (delta * delta <= heap.bound()) {
+        searchNearest(middle + 1, end, query, heap);
+      }
+    } else {
+      searchNearest(middle + 1, end, query, heap);
+      if (delta * delta <= heap.bound()) {
+        searchNearest(begin, middle, query, heap);
+      }
+    }
+  }
+
+  template<typename Fn>
+  void searchWithin(int begin, int end, const Point& query, Distance squaredRadius, Fn& fn) const {
+    if (end - begin <= LeafSize) {
+      for (int entry = begin; entry < end; ++entry) {
+        Distance distance = spatial::squaredDistance(query, entries[entry].point);
+        if (distance <= squaredRadius) {
+          fn(Neighbour{ entries[entry].index, distance });
+        }
+      }
+      return;
+    }
+    int middle = begin + (end - begin) / 2;
+    const Entry& split = entries[middle];
+    Distance delta = coordinate(query, axes[middle]) - coordinate(split.point, axes[middle]);
+    Distance distance = spatial::squaredDistance(query, split.point);
+    if (distance <= squaredRadius) {
+      fn(Neighbour{ split.index, distance });
+    }
+    if (delta <= 0 || delta * delta <= squaredRadius) {
+      searchWithin(begin, middle, query, squaredRadius, fn);
+    }
+    if (delta >= 0 || delta * delta <= squaredRadius) {
+      searchWithin(middle + 1, end, query, squaredRadius, fn);
+    }
+  }
+
+  std::vector<Point> points;   // in the original order
+  std::vector<Entry> entries;  // in tree order
+  std::vector<uint8_t> axes;   // split axis of the node at each middle index
+};
+
+using KdTree = KdTreeT<VectorT<int>>;
+using KdTree3D = KdTreeT<VectorT3D<int>>;
+
+
+/** Uniform grid of cubic cells, which are stored in a FlatHashMap, so only the occupied cells take up memory.
+ *  Unlike the k-d tree points can be inserted one at a time. Queries visit the cells around the query point ring by ring,
+ *  so they are fastest if a cell holds about one point (which the bulk constructor picks by default).
+ */
+template<typename Point>
+struct SpatialGridT {
+  using Traits = spatial::impl::PointTraits<Point>;
+  using Coordinate = typename Traits::Coordinate;
+  using Distance = spatial::Distance<Point>;
+  using Neighbour = spatial::NeighbourT<Distance>;
+  static_assert(std::is_integral_v<Coordinate>, "the grid needs integer coordinates");
+
+  explicit SpatialGridT(Coordinate cellSize) : cellSize(cellSize) {}
+
+  /** Inserts all points into a grid, whose cell size defaults to about one point per cell */
+  explicit SpatialGridT(const std::vector<Point>& points, Coordinate cellSize = 0) : cellSize(cellSize) {
+    if (this->cellSize <= 0) {
+      this->cellSize = defaultCellSize(points);
+    }
+    this->points.reserve(points.size());
+    cells.reserve(points.size());
+    for (const auto& point : points) {
+      insert(point);
+    }
+  }
+
+  /** Adds the point and returns its index */
+  int insert(const Point& point) {
+    int index = static_cast<int>(points.size());
+    points.push_back(point);
+    auto cell = cellOf(point);
+    for (int axis = 0; axis < Traits::Dims; ++axis) {
+      minCell[axis] = points.size() == 1 ? cell[axis] : std::min(minCell[axis], cell[axis]);
+      maxCell[axis] = points.size() == 1 ? cell[axis] : std::max(maxCell[axis], cell[axis]);
+    }
+    cells[Traits::make(cell)].push_back(index);
+    return index;
+  }
+
+  size_t size() const { return points.size(); }
+  const Point& operator[](int index) const { return points[index]; }
+
+  /** Returns the count nearest points to query ordered by their distance */
+  std::vector<Neighbour> nearest(const Point& query, int count) const {
+    spatial::impl::NearestHeap<Distance> heap(count);
+    if (count <= 0 || points.empty()) {
+      return heap.sorted();
+    }
+    auto center = cellOf(query);
+    Coordinate firstRing = 0, lastRing = 0;
+    for (int axis = 0; axis < Traits::Dims; ++axis) {
+      firstRing = std::max({ firstRing, minCell[axis] - center[axis], center[axis] - maxCell[axis] });
+      lastRing = std::max({ lastRing, center[axis] - minCell[axis], maxCell[axis] - center[axis] });
+    }
+
+    auto visitBucket = [&](const std::vector<int>& bucket) {
+      for (int index : bucket) {
+        heap.add(index, spatial::squaredDistance(query, points[index]));
+      }
+    };
+    for (Coordinate ring = firstRing; ring <= lastRing; ++ring) {
+      // Once a ring has more cells than the grid has occupied cells, the remaining occupied cells are checked directly
+      double ringCells = std::pow(2.0 * ring + 1, Traits::Dims) - (ring > 0 ? std::pow(2.0 * ring - 1, Traits::Dims) : 0);
+      if (ringCells > static_cast<double>(cells.size())) {
+        for (const auto& [cell, bucket] : cells) {
+          Coordinate cellRing = 0;
+          for (int axis = 0; axis < Traits::Dims; ++axis) {
+            cellRing = std::max<Coordinate>(cellRing, std::abs(Traits::get(cell, axis) - center[axis]));
+          }
+          if (cellRing >= ring) {
+            visitBucket(bucket);
+          }
+        }
+        break;
+      }
+
+      forEachRingCell(center, ring, [&](const Cell& cell) {
+        if (auto bucket = cells.get(Traits::make(cell))) {
+          visitBucket(*bucket);
+        }
+      });
+      // All points outside of the rings visited so far are further than ring * cellSize away from the query
+      Distance reach = static_cast<Distance>(ring) * cellSize;
+      if (heap.full() && heap.bound() <= reach * reach) {
+        break;
+      }
+    }
+    return heap.sorted();
+  }
+
+  /** Calls fn(Neighbour) for each point within the (squared) radius around query in no particular order */
+  template<typename Fn>
+  void forEachWithin(const Point& query, Distance squaredRadius, Fn&& fn) const {
+    auto visitBucket = [&](const std::vector<int>& bucket) {
+      for (int index : bucket) {
+        Distance distance = spatial::squaredDistance(query, points[index]);
+        if (distance <= squaredRadius) {
+          fn(Neighbour{ index, distance });
+        }
+      }
+    };
+
+    if (squaredRadius < 0) {
+      return;
+    }
+    Distance radius = static_cast<Distance>(std::ceil(std::sqrt(static_cast<double>(squaredRadius))));
+    std::array<Coordinate, Traits::Dims> min, max;
+    double boxCells = 1;
+    for (int axis = 0; axis < Traits::Dims; ++axis) {
+      // Clamped to the occupied cells before narrowing, so huge radii (e.g. the maximum to mean everything) don't wrap
+      Distance low = std::max<Distance>(minCell[axis], floorDiv(static_cast<Distance>(Traits::get(query, axis)) - radius));
+      Distance high = std::min<Distance>(maxCell[axis], floorDiv(static_cast<Distance>(Traits::get(query, axis)) + radius));
+      if (low > high) {
+        return;
+      }
+      min[axis] = static_cast<Coordinate>(low);
+      max[axis] = static_cast<Coordinate>(high);
+      boxCells *= static_cast<double>(max[axis] - min[axis] + 1);
+    }
+
+    // Large radii are cheaper to answer by checking every occupied cell
+    if (boxCells > static_cast<double>(cells.size())) {
+      for (const auto& [cell, bucket] : cells) {
+        visitBucket(bucket);
+      }
+      return;
+    }
+    std::array<Coordinate, Traits::Dims> cell = min;
+    while (true) {
+      if (auto bucket = cells.get(Traits::make(cell))) {
+        visitBucket(*bucket);
+      }
+      int axis = 0;
+      while (axis < Traits::Dims && cell[axis] == max[axis]) {
+        cell[axis] = min[axis];
+        ++axis;
+      }
+      if (axis == Traits::Dims) {
+        break;
+      }
+      ++cell[axis];
+    }
+  }
+
+  /** Returns all points within the (squared) radius around query ordered by their distance */
+  std::vector<Neighbour> within(const Point& query, Distance squaredRadius) const {
+    std::vector<Neighbour> result;
+    forEachWithin(query, squaredRadius, [&](const Neighbour& neighbour) { result.push_back(neighbour); });
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  /** Enumerates all pairs of points ordered by their distance, see spatial::ClosestPairs */
+  spatial::ClosestPairs<SpatialGridT> closestPairs() const { return spatial::ClosestPairs<SpatialGridT>(*this); }
+
+
+  Coordinate cellSize;
+
+private:
+  using Cell = std::array<Coordinate, Traits::Dims>;
+
+  /** Edge length of a cell, which holds one point on average if the points are spread evenly over their bounding box */
+  static Coordinate defaultCellSize(const std::vector<Point>& points) {
+    if (points.empty()) {
+      return 1;
+    }
+    double volume = 1;
+    for (int axis = 0; axis < Traits::Dims; ++axis) {
+      auto [min, max] = std::minmax_element(points.begin(), points.end(), [&](const Point& a, const Point& b) {
+        return Traits::get(a, axis) < Traits::get(b, axis);
+      });
+      volume *= static_cast<double>(Traits::get(*max, axis)) - static_cast<double>(Traits::get(*min, axis)) + 1;
+    }
+    return std::max<Coordinate>(1, static_cast<Coordinate>(std::ceil(std::pow(volume / points.size(), 1.0 / Traits::Dims))));
+  }
+
+  Distance floorDiv(Distance value) const {
+    Distance quotient = value / cellSize;
+    return quotient * cellSize > value ? quotient - 1 : quotient;
+  }
+
+  Cell cellOf(const Point& point) const {
+    Cell cell;
+    for (int axis = 0; axis < Traits::Dims; ++axis) {
+      cell[axis] = static_cast<Coordinate>(floorDiv(Traits::get(point, axis)));
+    }
+    return cell;
+  }
+
+  /** Calls fn(cell) for each cell, whose largest coordinate difference to center is exactly ring */
+  template<typename Fn>
+  static void forEachRingCell(const Cell& center, Coordinate ring, Fn&& fn) {
+    if (ring == 0) {
+      fn(center);
+      return;
+    }
+    Cell offset;
+    offset.fill(-ring);
+    while (true) {
+      // The last axis only needs its two end cells, unless another axis is already on the ring
+      bool onRing = false;
+      for (int axis = 0; axis + 1 < Traits::Dims; ++axis) {
+        onRing |= offset[axis] == -ring || offset[axis] == ring;
+      }
+      Cell cell;
+      for (int axis = 0; axis + 1 < Traits::Dims; ++axis) {
+        cell[axis] = center[axis] + offset[axis];
+      }
+      constexpr int Last = Traits::Dims - 1;
+      for (Coordinate last = -ring; last <= ring; last += onRing ? 1 : 2 * ring) {
+        cell[Last] = center[Last] + last;
+        fn(cell);
+      }
+
+      int axis = 0;
+      while (axis < Last && offset[axis] == ring) {
+        offset[axis] = -ring;
+        ++axis;
+      }
+      if (axis == Last) {
+        break;
+      }
+      ++offset[axis];
+    }
+  }
+
+  std::vector<Point> points;
+  FlatHashMap<Point, std::vector<int>> cells;
+  Cell minCell{}, maxCell{}; // bounds of the occupied cells
+};
+
+using SpatialGrid = SpatialGridT<VectorT<int>>;
+using SpatialGrid3D = SpatialGridT<VectorT3D<int>>;
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "field.hpp"
+#include "bitfield.hpp"
+#include "parallel.hpp"
+
+namespace stencil {
+  /** Read only view of a cell and its 8 neighbours passed to the rules of StencilT::step().
+   *  Cells outside of the field have the border value of the stencil.
+   */
+  template<typename T>
+  struct Neighbourhood {
+    const T& operator*() const { return *center; }
+    const T& operator[](const Vector& delta) const { return center[delta.y * stride + delta.x]; }
+
+    /** Number of the 8 neighbours equal to value */
+    int count(const T& value) const {
+      const T* above = center - stride;
+      const T* below = center + stride;
+      return (above[-1] == value) + (above[0] == value) + (above[1] == value) + (center[-1] == value) +
+             (center[1] == value) + (below[-1] == value) + (below[0] == value) + (below[1] == value);
+    }
+
+    Vector pos;
+    const T* center;
+    int stride;
+  };
+
+
+  /** Fields with fewer cells are processed on the calling thread, as waking the pool costs more than the step itself */
+  constexpr size_t MinParallelCells = 1 << 14;
+}
+
+
+/** Double buffered engine for cellular automata over a field (Game of Life, spreading, sliding simulations...).
+ *  The cells are kept with a one cell border of fixed value around them, so rules can access all 8 neighbours
+ *  without bounds checks. Each step writes the next generation into the second pre-allocated buffer and swaps
+ *  them afterwards, with the rows being split into bands across the workers of the thread pool.
+ */
+template<typename T>
+struct StencilT {
+  StencilT(const FieldT<T>& field, T border = T{}) : size(field.size), border(border), stride(field.size.x + 2) {
+    current.assign(static_cast<size_t>(stride) * (size.y + 2), border);
+    for (int y = 0; y < size.y; ++y) {
+      std::copy_n(field.data.begin() + field.toOffset(Vector(0, y)), size.x, current.begin() + toOffset(Vector(0, y)));
+    }
+    next = current;
+  }
+
+  const T& operator[](const Vector& pos) const { return current[toOffset(pos)]; }
+  bool validPosition(const Vector& pos) const { return pos.x >= 0 && pos.y >= 0 && pos.x < size.x && pos.y < size.y; }
+  T at(const Vector& pos) const { return validPosition(pos) ? current[toOffset(pos)] : border; }
+  void set(const Vector& pos, const T& value) { current[toOffset(pos)] = value; }
+
+  /** Computes the next generation with newCell = rule(const stencil::Neighbourhood<T>&).
+   *  The rule is called concurrently for different rows and must therefore not modify shared state.
+   */
+  template<typename Rule>
+  StencilT& step(Rule&& rule, parallel::ThreadPool& pool = parallel::pool()) {
+    forRows(pool, [&](int y, unsigned) {
+      stencil::Neighbourhood<T> cells{ Vector(0, y), &current[toOffset(Vector(0, y))], stride };
+      T* out = &next[toOffset(Vector(0, y))];
+      for (int x = 0; x < size.x; ++x, ++cells.pos.x, ++cells.center) {
+        out[x] = rule(cells);
+      }
+    });
+    return swap();
+  }
+
+  /** Fast path for counting rules (e.g. Game of Life) with newCell = rule(const T& cell, int count), where count is the number
+   *  of the 8 neighbours equal to value. The counts of a whole row are computed by plain byte loops, which the compiler vectorizes.
+   */
+  template<typename Rule>
+  StencilT& stepCounting(const T& value, Rule&& rule, parallel::ThreadPool& pool = parallel::pool()) {
+    scratch.resize(pool.size());
+    forRows(pool, [&](int y, unsigned worker) {
+      auto& columns = scratch[worker];
+      columns.resize(static_cast<size_t>(stride) * 2);
+      uint8_t* columnSums = columns.data();
+      uint8_t* center = columns.data() + stride;
+
+      const T* above = &current[toOffset(Vector(-1, y - 1))];
+      const T* row = above + stride;
+      const T* below = row + stride;
+      for (int x = 0; x < stride; ++x) {
+        center[x] = row[x] == value;
+        columnSums[x] = static_cast<uint8_t>((above[x] == value) + center[x] + (below[x] == value));
+      }
+
+      T* out = &next[toOffset(Vector(0, y))];
+      for (int x = 0; x < size.x; ++x) {
+        int count = columnSums[x] + columnSums[x + 1] + columnSums[x + 2] - center[x + 1];
+        out[x] = rule(row[x + 1], count);
+      }
+    });
+    return swap();
+  }
+
+  /** Applies the rule for the given number of generations */
+  template<typename Rule>
+  StencilT& run(int generations, Rule&& rule, parallel::ThreadPool& pool = parallel::pool()) {
+    for (int i = 0; i < generations; ++i) {
+      step(rule, pool);
+    }
+    return *this;
+  }
+
+  /** Number of cells equal to value */
+  size_t count(const T& value) const {
+    size_t result = 0;
+    for (int y = 0; y < size.y; ++y) {
+      result += scan::count(std::span<const T>(&current[toOffset(Vector(0, y))], size.x), value);
+    }
+    return result;
+  }
+
+  /** Copies the current generation into a field */
+  FieldT<T> field() const {
+    FieldT<T> result(size.x, size.y, border);
+    for (int y = 0; y < size.y; ++y) {
+      std::copy_n(current.begin() + toOffset(Vector(0, y)), size.x, result.data.begin() + result.toOffset(Vector(0, y)));
+    }
+    return result;
+  }
+
+
+  Vector size;
+  T border;
+  int stride; // row length including the border cells
+  int generation = 0;
+
+private:
+  int toOffset(const Vector& pos) const { return (pos.y + 1) * stride + pos.x + 1; }
+
+  template<typename Fn>
+  void forRows(parallel::ThreadPool& pool, Fn&& fn) {
+    if (static_cast<size_t>(size.x) * size.y < stencil::MinParallelCells) {
+      for (int y = 0; y < size.y; ++y) {
+        fn(y, 0u);
+      }
+      return;
+    }
+    pool.forBands(size.y, [&](size_t begin, size_t end, unsigned worker) {
+      for (size_t y = begin; y < end; ++y) {
+        fn(static_cast<int>(y), worker);
+      }
+    });
+  }
+
+  StencilT& swap() {
+    std::swap(current, next);
+    ++generation;
+    return *this;
+  }
+
+  std::vector<T> current, next; // padded row major cells
+  std::vector<std::vector<uint8_t>> scratch; // per worker count rows for stepCounting()
+};
+
+using Stencil = StencilT<char>;
+
+
+namespace stencil {
+  /** Life-like step on a bit field with cells outside of the field being dead. Bit i of birth/survive enables birth/survival of a cell
+   *  with i live neighbours (the default is Conway's B3/S23). The neighbours of 64 cells are summed at once into four bit planes.
+   */
+  inline BitField lifeStep(const BitField& cells, unsigned birth = 1u << 3, unsigned survive = (1u << 2) | (1u << 3), parallel::ThreadPool& pool = parallel::pool()) {
+    using Word = BitField::Word;
+    BitField result(cells.size.x, cells.size.y);
+    int rowWords = cells.rowWords;
+    int lastBits = cells.size.x % BitField::WordBits;
+    Word lastMask = lastBits == 0 ? ~Word(0) : (Word(1) << lastBits) - 1;
+
+    auto computeRows = [&](size_t begin, size_t end, unsigned) {
+      for (size_t y = begin; y < end; ++y) {
+        const Word* rows[3] = {
+          y > 0 ? &cells.words[(y - 1) * rowWords] : nullptr,
+          &cells.words[y * rowWords],
+          y + 1 < static_cast<size_t>(cells.size.y) ? &cells.words[(y + 1) * rowWords] : nullptr,
+        };
+        for (int word = 0; word < rowWords; ++word) {
+          Word planes[4] = {}; // bit sliced neighbour count
+          auto add = [&](Word bits) {
+            for (auto& plane : planes) {
+              Word carry = plane & bits;
+              plane ^= bits;
+              bits = carry;
+            }
+          };
+
+          for (int row = 0; row < 3; ++row) {
+            if (!rows[row]) {
+              continue;
+            }
+            Word cellsWord = rows[row][word];
+            add((cellsWord << 1) | (word > 0 ? rows[row][word - 1] >> (BitField::WordBits - 1) : 0));
+            add((cellsWord >> 1) | (word + 1 < rowWords ? rows[row][word + 1] << (BitField::WordBits - 1) : 0));
+            if (row != 1) {
+              add(cellsWord);
+            }
+          }
+
+          Word alive = rows[1][word], born = 0, survived = 0;
+          for (unsigned count = 0; count <= 8; ++count) {
+            if (((birth | survive) >> count) & 1) {
+              Word equal = ~Word(0);
+              for (int plane = 0; plane < 4; ++plane) {
+                equal &= ((count >> plane) & 1) ? planes[plane] : ~planes[plane];
+              }
+              born |= ((birth >> count) & 1) ? equal : 0;
+              survived |= ((survive >> count) & 1) ? equal : 0;
+            }
+          }
+          Word next = (~alive & born) | (alive & survived);
+          result.words[y * rowWords + word] = word + 1 == rowWords ? next & lastMask : next;
+        }
+      }
+    };
+
+    if (static_cast<size_t>(cells.size.x) * cells.size.y < MinParallelCells) {
+      computeRows(0, cells.size.y, 0);
+    } else {
+      pool.forBands(cells.size.y, computeRows);
+    }
+    return result;
+  }
+}
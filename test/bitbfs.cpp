@@ -0,0 +1,86 @@
+// Checks for BitBFST against PathFinderT and a brute force walk simulation.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <random>
+#include <cassert>
+#include <cstdio>
+
+#include "../paths.hpp"
+#include "../bitbfs.hpp"
+
+namespace {
+  /** Number of cells in which a walk of exactly the given number of steps from source can end */
+  size_t walkEnds(const Field& field, Vector source, int steps) {
+    BitField current(field.size.x, field.size.y), next = current;
+    current[source] = true;
+    for (int step = 0; step < steps; ++step) {
+      next = BitField(field.size.x, field.size.y);
+      for (int y = 0; y < field.size.y; ++y) {
+        for (int x = 0; x < field.size.x; ++x) {
+          if (current[Vector(x, y)]) {
+            forEachNeighbour(Vector(x, y), [&](const Vector& neighbour) {
+              if (field.validPosition(neighbour) && field[neighbour] != '#') {
+                next[neighbour] = true;
+              }
+            });
+          }
+        }
+      }
+      std::swap(current, next);
+    }
+    return current.count();
+  }
+}
+
+int main() {
+  // A source without open neighbours can only be the end of a walk with 0 steps
+  {
+    Field field(3, 3, '#');
+    field[Vector(1, 1)] = '.';
+    PathFinder finder(field);
+    finder.findPath(Vector(1, 1), Vector(0, 0), true);
+    BitBFS bfs(field);
+    assert(bfs.run(Vector(1, 1)) == 0);
+    assert(bfs.reachableInExactly(0) == 1);
+    assert(bfs.reachableInExactly(2) == 0);
+    assert(bfs.reachableWithin(2) == 1);
+    assert(finder.getCost(Vector(1, 1)) == 0 && finder.expandedNodes == 1);
+  }
+
+  // A wall source cannot be entered again and neither can a dead end next to it be left
+  {
+    Field field(3, 1, '.');
+    field[Vector(1, 0)] = '#';
+    BitBFS bfs(field);
+    bfs.run(Vector(1, 0));
+    assert(bfs.reachableInExactly(1) == 2);
+    assert(bfs.reachableInExactly(2) == 0);
+    assert(bfs.reachableInExactly(3) == 0);
+  }
+
+  std::mt19937 rng(5);
+  for (int iteration = 0; iteration < 300; ++iteration) {
+    int width = 1 + rng() % 90, height = 1 + rng() % 20;
+    Field field(width, height, '.');
+    for (auto& cell : field.data) {
+      cell = rng() % 100 < 35 ? '#' : '.';
+    }
+    Vector source(rng() % width, rng() % height); // may be a wall
+
+    PathFinder finder(field);
+    finder.findPath(source, Vector(-1, -1), true);
+    BitBFS bfs(field);
+    FieldT<int> distances(0, 0, 0);
+    bfs.run(source, std::numeric_limits<int>::max(), &distances);
+    for (int offset = 0; offset < width * height; ++offset) {
+      int cost = finder.getCost(field.fromOffset(offset));
+      assert(distances.data[offset] == (cost == PathFinder::Unreachable ? -1 : cost));
+    }
+
+    for (int steps = 0; steps < 12; ++steps) {
+      assert(bfs.reachableInExactly(steps) == walkEnds(field, source, steps));
+    }
+  }
+
+  puts("bitbfs: ok");
+}
@@ -0,0 +1,63 @@
+// Checks for BitField.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <random>
+#include <cassert>
+#include <cstdio>
+#include <sstream>
+
+#include "../bitfield.hpp"
+
+int main() {
+  // findOffset() on empty fields and across word and row boundaries
+  {
+    constexpr size_t None = std::numeric_limits<size_t>::max();
+    BitField empty;
+    assert(empty.findOffset(true) == None);
+    assert(empty.findOffset(false, 5) == None);
+    assert(BitField(0, 3).findOffset(false) == None);
+
+    BitField field(70, 2);
+    field[Vector(65, 1)] = true;
+    assert(field.findOffset(true) == 70 + 65);
+    assert(field.findOffset(true, 70 + 66) == None);
+    assert(field.findOffset(false, 70 + 65) == 70 + 66);
+  }
+
+  // bitsAt() at any position and transposed() against single cell reads
+  {
+    std::mt19937 rng(11);
+    for (Vector size : { Vector(1, 1), Vector(64, 64), Vector(70, 130), Vector(200, 3) }) {
+      BitField field(size.x, size.y);
+      for (int y = 0; y < size.y; ++y) {
+        for (int x = 0; x < size.x; ++x) {
+          field[Vector(x, y)] = rng() % 3 == 0;
+        }
+      }
+      auto transposed = field.transposed();
+      assert(transposed.size == Vector(size.y, size.x));
+      for (int y = -1; y <= size.y; ++y) {
+        for (int x = -70; x <= size.x; ++x) {
+          auto bits = field.bitsAt(y, x);
+          for (int bit = 0; bit < BitField::WordBits; ++bit) {
+            assert(((bits >> bit) & 1) == field.at(Vector(x + bit, y), false));
+          }
+          if (field.validPosition(Vector(x, y))) {
+            assert(transposed[Vector(y, x)] == field[Vector(x, y)]);
+          }
+        }
+      }
+      assert(transposed.transposed() == field);
+    }
+  }
+
+  {
+    BitField field(3, 2);
+    field[Vector(1, 1)] = true;
+    std::ostringstream out;
+    out << field;
+    assert(out.str() == "...\n.#.\n");
+  }
+
+  puts("bitfield: ok");
+}
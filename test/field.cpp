@@ -0,0 +1,56 @@
+// Checks for FieldT offsets with padding and layouts.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <cassert>
+#include <cstdio>
+
+#include "../field.hpp"
+
+namespace {
+  template<typename Layout>
+  void checkPadded(int padding) {
+    FieldT<int, Layout> plain(13, 7, 0);
+    for (int offset = 0; offset < 13 * 7; ++offset) {
+      plain[Vector(offset % 13, offset / 13)] = offset;
+    }
+    FieldT<int, Layout> padded(plain, padding, -1);
+    for (int y = -padding; y < 7 + padding; ++y) {
+      for (int x = -padding; x < 13 + padding; ++x) {
+        Vector pos(x, y);
+        int offset = padded.toOffset(pos);
+        assert(offset >= 0 && offset < static_cast<int>(padded.data.size()));
+        if (plain.validPosition(pos)) {
+          assert(padded[pos] == plain[pos] && padded.fromOffset(offset) == pos);
+        } else {
+          assert(padded.data[offset] == -1 && !padded.validPosition(padded.fromOffset(offset)));
+        }
+      }
+    }
+    assert(padded.findOffset(42) == static_cast<size_t>(padded.toOffset(Vector(42 % 13, 42 / 13))));
+    assert(padded.count(-1) == 0);
+  }
+}
+
+int main() {
+  // Unpadded row major fields use the plain row major offsets
+  {
+    Field field(5, 3, '.');
+    assert(field.toOffset(Vector(4, 2)) == 14);
+    assert(field.fromOffset(7) == Vector(2, 1));
+  }
+
+  for (int padding : { 0, 1, 2, 5 }) {
+    checkPadded<layout::RowMajor>(padding);
+    checkPadded<layout::Tiled<4>>(padding);
+    checkPadded<layout::Morton>(padding);
+  }
+
+  // Padding is gone after assign()
+  {
+    Field field(Field(4, 4, '.'), 2, '#');
+    field.assign(Vector(3, 2), 'x');
+    assert(!field.isPadded() && field.toOffset(Vector(2, 1)) == 5 && field.data.size() == 6);
+  }
+
+  puts("field: ok");
+}
@@ -0,0 +1,100 @@
+// Checks for FlatHashMap and FlatHashSet against std::unordered_map.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <random>
+#include <limits>
+#include <string>
+#include <utility>
+#include <cassert>
+#include <cstdio>
+#include <unordered_map>
+
+#include "../vector.hpp"
+#include "../flathash.hpp"
+
+int main() {
+  // Random inserts, erases and lookups on key ranges from a few keys (mostly tombstones) to a few thousand
+  std::mt19937 rng(5);
+  for (int round = 0; round < 20; ++round) {
+    FlatHashMap<Vector, int> map;
+    std::unordered_map<Vector, int> reference;
+    int range = 1 + rng() % 60;
+    for (int operation = 0; operation < 20000; ++operation) {
+      Vector key(static_cast<int>(rng() % (2 * range)) - range, static_cast<int>(rng() % (2 * range)) - range);
+      switch (rng() % 4) {
+        case 0:
+          map[key] += operation;
+          reference[key] += operation;
+          break;
+        case 1:
+          assert(map.erase(key) == reference.erase(key));
+          break;
+        case 2: {
+          auto [entry, inserted] = map.emplace(key, operation);
+          auto [referenceEntry, referenceInserted] = reference.emplace(key, operation);
+          assert(inserted == referenceInserted && entry->second == referenceEntry->second);
+          break;
+        }
+        default: {
+          auto value = map.get(key);
+          auto entry = reference.find(key);
+          assert((value != nullptr) == (entry != reference.end()) && map.contains(key) == (entry != reference.end()));
+          assert(!value || *value == entry->second);
+        }
+      }
+      assert(map.size() == reference.size());
+    }
+
+    size_t visited = 0;
+    for (auto& [key, value] : map) {
+      assert(reference.at(key) == value);
+      ++visited;
+    }
+    assert(visited == reference.size());
+    const auto& constMap = map;
+    for (auto entry = constMap.begin(); entry != constMap.end(); ++entry) {
+      assert(reference.contains(entry->first));
+    }
+    map.clear();
+    assert(map.empty() && !map.contains(Vector(0, 0)) && map.begin() == map.end());
+  }
+
+  for (Vector key : { Vector(-5, 7), Vector(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()), Vector(0, -1) }) {
+    assert(unpackKey(packKey(key)) == key);
+  }
+
+  // A mutable iterator converts to a const one
+  {
+    FlatHashMap<int, int> map;
+    map[1] = 2;
+    FlatHashMap<int, int>::iterator entry = map.begin();
+    decltype(std::as_const(map).begin()) constEntry = entry;
+    assert(constEntry->second == 2);
+  }
+
+  // Copies are independent and moved from containers are empty and usable
+  {
+    FlatHashMap<Vector, std::string> map;
+    for (int index = 0; index < 100; ++index) {
+      map[Vector(index, -index)] = std::to_string(index);
+    }
+    auto moved = std::move(map);
+    assert(moved.size() == 100 && map.empty() && !map.contains(Vector(1, -1)) && map.begin() == map.end());
+    map[Vector(1, 1)] = "x";
+    assert(map.size() == 1 && *map.get(Vector(1, 1)) == "x");
+
+    FlatHashMap<Vector, std::string> assigned;
+    assigned[Vector(0, 0)] = "y";
+    assigned = std::move(moved);
+    assert(assigned.size() == 100 && moved.empty() && !moved.contains(Vector(0, 0)));
+    auto copy = assigned;
+    copy[Vector(5, -5)] = "changed";
+    assert(copy.size() == 100 && *assigned.get(Vector(5, -5)) == "5");
+
+    FlatHashSet<Vector> set;
+    assert(set.insert(Vector(1, 2)).second && !set.insert(Vector(1, 2)).second);
+    auto movedSet = std::move(set);
+    assert(!set.contains(Vector(1, 2)) && movedSet.contains(Vector(1, 2)) && movedSet.size() == 1);
+  }
+  puts("flathash: ok");
+}
@@ -0,0 +1,44 @@
+// Checks for IncrementalPathFinderT against a fresh PathFinderT after random cell changes.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <random>
+#include <cstdlib>
+#include <cassert>
+#include <cstdio>
+
+#include "../paths.hpp"
+
+int main() {
+  std::mt19937 rng(9);
+  for (int round = 0; round < 300; ++round) {
+    int width = 3 + rng() % 30, height = 3 + rng() % 30;
+    Field field(width, height, '.');
+    for (auto& cell : field.data) {
+      cell = rng() % 100 < 20 ? '#' : '.';
+    }
+    Vector from(rng() % width, rng() % height), to(rng() % width, rng() % height);
+    field[from] = '.';
+
+    IncrementalPathFinder incremental(field, from, to);
+    for (int change = 0; change < 60; ++change) {
+      incremental.setCell(Vector(rng() % width, rng() % height), rng() % 3 ? '#' : '.');
+      if (rng() % 2) {
+        continue; // re-plan after several changes as well
+      }
+
+      int cost = incremental.findPath();
+      PathFinder finder(field);
+      assert(cost == finder.findPath(from, to));
+
+      auto path = incremental.getCheapestPath();
+      if (cost >= 0) {
+        assert(static_cast<int>(path.size()) == cost + 1 && path.front() == from && path.back() == to);
+        for (size_t step = 1; step < path.size(); ++step) {
+          auto delta = path[step] - path[step - 1];
+          assert(std::abs(delta.x) + std::abs(delta.y) == 1 && field[path[step]] != '#');
+        }
+      }
+    }
+  }
+  puts("incremental: ok");
+}
@@ -0,0 +1,67 @@
+// Checks JumpPointPathFinderT against the costs of PathFinderT on random mazes.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <random>
+#include <cassert>
+#include <cstdio>
+
+#include "../paths.hpp"
+
+// The cheapest path DAG queries need the neighbours of every position
+template<typename Finder>
+concept CheapestPathQueries = requires(const Finder& finder) { finder.countCheapestPaths(); finder.onAnyCheapestPath(); };
+static_assert(CheapestPathQueries<PathFinder> && !CheapestPathQueries<JumpPointPathFinder>);
+
+namespace {
+  /** Checks that path is a walk of cost + 1 open positions from->to in the given directions */
+  void checkPath(const Field& field, const std::vector<Vector>& path, Vector from, Vector to, int cost, std::span<const Vector> directions) {
+    assert(static_cast<int>(path.size()) == cost + 1);
+    assert(path.front() == from && path.back() == to);
+    for (size_t step = 1; step < path.size(); ++step) {
+      assert(std::ranges::find(directions, path[step] - path[step - 1]) != directions.end());
+      assert(field[path[step]] != '#');
+    }
+  }
+}
+
+int main() {
+  std::mt19937 rng(9);
+  for (int iteration = 0; iteration < 1500; ++iteration) {
+    int width = 1 + rng() % 150, height = 1 + rng() % 70;
+    int wallPercent = rng() % 45;
+    Field field(width, height, '.');
+    for (auto& cell : field.data) {
+      cell = static_cast<int>(rng() % 100) < wallPercent ? '#' : '.';
+    }
+    Vector from(rng() % width, rng() % height), to(rng() % width, rng() % height);
+    if (iteration % 3 != 0) {
+      field[from] = field[to] = '.';
+    }
+    Field padded(field, 1, '#');
+
+    for (bool diagonal : { false, true }) {
+      std::span<const Vector> directions = diagonal ? Vector::AllDirections() : Vector::AllSimpleDirections();
+      PathFinder finder(field);
+      finder.directions = directions;
+      int cost = finder.findPath(from, to);
+
+      JumpPointPathFinder jumpFinder(field), paddedFinder(padded);
+      jumpFinder.directions = paddedFinder.directions = directions;
+      assert(jumpFinder.findPath(from, to) == cost);
+      if (cost != -1) {
+        checkPath(field, jumpFinder.getCheapestPath(), from, to, cost, directions);
+      } else {
+        assert(jumpFinder.getCheapestPath().empty());
+      }
+      assert(paddedFinder.findPath(from, to) == cost);
+
+      int aStarCost = diagonal ? jumpFinder.findPathAStar(from, to, heuristic::Chebyshev()) : jumpFinder.findPathAStar(from, to);
+      assert(aStarCost == cost);
+      if (cost != -1) {
+        checkPath(field, jumpFinder.getCheapestPath(), from, to, cost, directions);
+      }
+    }
+  }
+
+  puts("jumppoint: ok");
+}
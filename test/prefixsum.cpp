@@ -0,0 +1,64 @@
+// Checks for SummedAreaTableT and FenwickTree2DT against summing the cells in loops.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <random>
+#include <cassert>
+#include <cstdio>
+
+#include "../prefixsum.hpp"
+
+namespace {
+  int64_t countWalls(const Field& field, Vector min, Vector max) {
+    int64_t count = 0;
+    for (int y = std::max(min.y, 0); y <= std::min(max.y, field.size.y - 1); ++y) {
+      for (int x = std::max(min.x, 0); x <= std::min(max.x, field.size.x - 1); ++x) {
+        count += field[Vector(x, y)] == '#';
+      }
+    }
+    return count;
+  }
+}
+
+int main() {
+  auto wall = [](char cell) { return cell == '#'; };
+  parallel::ThreadPool pool(4);
+  std::mt19937 rng(1);
+
+  // Small fields stay on the calling thread, the large ones are split into bands
+  for (int round = 0; round < 40; ++round) {
+    bool large = round % 10 == 9;
+    int width = large ? 300 + rng() % 100 : 1 + rng() % 40, height = large ? 300 + rng() % 100 : 1 + rng() % 40;
+    Field field(width, height, '.');
+    for (auto& cell : field.data) {
+      cell = rng() % 3 == 0 ? '#' : '.';
+    }
+
+    SummedAreaTable table(field, wall, pool);
+    FenwickTree2D tree(field, wall);
+    assert(table.total() == static_cast<int64_t>(field.count('#')));
+    // Rectangles may reach outside of the field and may be empty (min > max)
+    for (int query = 0; query < 200; ++query) {
+      Vector min(static_cast<int>(rng() % (width + 4)) - 2, static_cast<int>(rng() % (height + 4)) - 2);
+      Vector max(static_cast<int>(rng() % (width + 4)) - 2, static_cast<int>(rng() % (height + 4)) - 2);
+      auto expected = countWalls(field, min, max);
+      assert(table.sum(min, max) == expected && tree.sum(min, max) == expected);
+    }
+
+    // Only the marked rows are projected again
+    for (int change = 0; change < 20; ++change) {
+      Vector pos(rng() % width, rng() % height);
+      field[pos] = field[pos] == '#' ? '.' : '#';
+      table.markDirty(pos.y);
+      tree.set(pos, field[pos] == '#');
+    }
+    table.rebuild(field, wall, pool);
+    for (int query = 0; query < 200; ++query) {
+      Vector min(rng() % width, rng() % height), max(rng() % width, rng() % height);
+      auto expected = countWalls(field, min, max);
+      assert(table.sum(min, max) == expected && tree.sum(min, max) == expected);
+      assert(table.sumAt(min, Vector(1, 1)) == (field[min] == '#'));
+    }
+    assert(table.total() == static_cast<int64_t>(field.count('#')));
+  }
+  puts("prefixsum: ok");
+}
@@ -0,0 +1,100 @@
+// Checks for findRegions() against a flood fill with std::set.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <set>
+#include <random>
+#include <sstream>
+#include <cassert>
+#include <cstdio>
+
+#include "../regions.hpp"
+
+namespace {
+  /** Flood fills the regions in row major order of their first cell, counting corners as in the usual fence pricing puzzles */
+  std::vector<RegionT<char>> floodFill(const Field& field, bool diagonal, FieldT<int>& labels) {
+    std::vector<RegionT<char>> regions;
+    std::set<Vector> seen;
+    labels = FieldT<int>(field.size.x, field.size.y, -1);
+    for (int y = 0; y < field.size.y; ++y) {
+      for (int x = 0; x < field.size.x; ++x) {
+        Vector start(x, y);
+        if (!seen.insert(start).second) {
+          continue;
+        }
+        RegionT<char> region;
+        region.value = field[start];
+        region.first = region.min = region.max = start;
+        std::vector<Vector> stack = { start };
+        while (!stack.empty()) {
+          auto pos = stack.back();
+          stack.pop_back();
+          labels[pos] = static_cast<int>(regions.size());
+          ++region.area;
+          region.min = Vector(std::min(region.min.x, pos.x), std::min(region.min.y, pos.y));
+          region.max = Vector(std::max(region.max.x, pos.x), std::max(region.max.y, pos.y));
+          for (auto direction : Vector::AllSimpleDirections()) {
+            auto side = direction.rotateCW();
+            bool same = field.isAt(region.value, pos + direction), sideSame = field.isAt(region.value, pos + side);
+            region.perimeter += !same;
+            region.corners += (!same && !sideSame) || (same && sideSame && !field.isAt(region.value, pos + direction + side));
+          }
+          for (auto direction : diagonal ? Vector::AllDirections() : Vector::AllSimpleDirections()) {
+            auto next = pos + direction;
+            if (field.isAt(region.value, next) && seen.insert(next).second) {
+              stack.push_back(next);
+            }
+          }
+        }
+        regions.push_back(region);
+      }
+    }
+    return regions;
+  }
+
+  void compare(const Field& field, bool diagonal, parallel::ThreadPool& pool) {
+    FieldT<int> labels(0, 0, -1);
+    auto expected = floodFill(field, diagonal, labels);
+    auto result = findRegions(field, diagonal, pool);
+    assert(result.labels.data == labels.data && result.regions.size() == expected.size());
+    for (size_t index = 0; index < expected.size(); ++index) {
+      auto& region = result.regions[index];
+      auto& reference = expected[index];
+      assert(region.value == reference.value && region.first == reference.first && region.area == reference.area);
+      assert(region.perimeter == reference.perimeter && region.corners == reference.corners);
+      assert(region.min == reference.min && region.max == reference.max);
+    }
+  }
+}
+
+int main() {
+  // Example of the 2024 day 12 puzzle: fence price by perimeter and by sides
+  {
+    auto result = findRegions(Field(std::istringstream("AAAA\nBBCD\nBBCC\nEEEC\n")));
+    size_t perimeterPrice = 0, sidesPrice = 0;
+    for (auto& region : result.regions) {
+      perimeterPrice += region.area * region.perimeter;
+      sidesPrice += region.area * region.sides();
+    }
+    assert(perimeterPrice == 140 && sidesPrice == 80);
+  }
+
+  parallel::ThreadPool pool(4);
+  std::mt19937 rng(5);
+  for (int round = 0; round < 80; ++round) {
+    Field field(1 + rng() % 50, 1 + rng() % 50, '.');
+    for (auto& cell : field.data) {
+      cell = static_cast<char>('a' + rng() % 3);
+    }
+    compare(field, round % 2 == 1, pool);
+  }
+
+  // Large enough to be split into row bands, which are joined at their borders
+  for (bool diagonal : { false, true }) {
+    Field field(300, 400, '.');
+    for (auto& cell : field.data) {
+      cell = static_cast<char>('a' + rng() % 2);
+    }
+    compare(field, diagonal, pool);
+  }
+  puts("regions: ok");
+}
@@ -0,0 +1,20 @@
+@echo off
+rem Builds and runs each check in this directory (x64 Native Tools prompt): test\run.cmd
+setlocal enabledelayedexpansion
+cd /d "%~dp0"
+if not exist build mkdir build
+set failed=0
+for %%f in (*.cpp) do (
+  if exist build\%%~nf.exe del build\%%~nf.exe
+  cl /nologo /std:c++latest /O2 /EHsc /Fobuild\ /Febuild\ %%f > build\%%~nf.log
+  if exist build\%%~nf.exe (
+    build\%%~nf.exe || (
+      echo %%~nf: FAILED
+      set failed=1
+    )
+  ) else (
+    echo %%~nf: build failed, see test\build\%%~nf.log
+    set failed=1
+  )
+)
+exit /b !failed!
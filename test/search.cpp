@@ -0,0 +1,40 @@
+// Checks for SearchT and PathFinderT on small fields.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <cassert>
+#include <cstdio>
+
+#include "../paths.hpp"
+
+int main() {
+  // The same start state passed twice is expanded once and counted as one path
+  {
+    Field field(6, 6, '.');
+    PathFinder finder(field);
+    std::vector<Vector> starts = { Vector(0, 0), Vector(0, 0), Vector(5, 5) };
+    int cost = finder.Base::findPath(std::span<const Vector>(starts), [](const Vector& position) { return position == Vector(3, 3); }, true);
+    assert(cost == 4);
+    assert(finder.expandedNodes == 36);
+    assert(finder.Base::countCheapestPaths(Vector(3, 3)) == 6);
+  }
+
+  // Finders sharing a workspace only report the results of the search, which ran last
+  {
+    Field field(5, 5, '.');
+    SearchWorkspace workspace;
+    PathFinder first(field, &workspace), second(field, &workspace);
+    assert(first.getCost(Vector(0, 0)) == PathFinder::Unreachable);
+    assert(first.findPath(Vector(0, 0), Vector(4, 4)) == 8);
+    assert(first.getCost(Vector(0, 0)) == 0);
+    assert(second.findPath(Vector(4, 4), Vector(0, 4)) == 4);
+    assert(second.getCost(Vector(4, 4)) == 0);
+    assert(first.getCost(Vector(0, 0)) == PathFinder::Unreachable);
+    assert(first.getCheapestPath().empty());
+    assert(first.countCheapestPaths() == 0);
+    assert(second.getCheapestPath().size() == 5);
+    assert(first.findPath(Vector(0, 0), Vector(4, 4)) == 8);
+    assert(second.getCost(Vector(4, 4)) == PathFinder::Unreachable);
+  }
+
+  puts("search: ok");
+}
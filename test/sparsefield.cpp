@@ -0,0 +1,93 @@
+// Checks for SparseFieldT against a std::map reference.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <map>
+#include <atomic>
+#include <random>
+#include <cassert>
+#include <cstdio>
+
+#include "../parallel.hpp"
+#include "../sparsefield.hpp"
+
+int main() {
+  std::mt19937 rng(3);
+  SparseField field('.');
+  std::map<std::pair<int, int>, char> reference;
+  for (int write = 0; write < 20000; ++write) {
+    Vector pos(static_cast<int>(rng() % 400) - 200, static_cast<int>(rng() % 400) - 200);
+    char value = static_cast<char>('a' + rng() % 3);
+    field[pos] = value;
+    reference[{ pos.x, pos.y }] = value;
+  }
+
+  // Reads through the const interface see the written cells and the fill value elsewhere
+  const SparseField& constField = field;
+  for (auto& [key, value] : reference) {
+    assert(constField[Vector(key.first, key.second)] == value);
+  }
+  assert(constField[Vector(100000, -100000)] == '.' && !constField.at(Vector(100000, 5)) && constField.at(Vector(100000, 5), 'x') == 'x');
+  assert(!constField.isAllocated(Vector(100000, 5)) && constField.isAllocated(Vector(-200, -200)));
+
+  // Iteration visits every cell of the allocated chunks once with its position
+  {
+    size_t cells = 0, written = 0;
+    std::map<std::pair<int, int>, int> visits;
+    for (auto it = constField.begin(); it != constField.end(); ++it) {
+      ++cells;
+      ++visits[{ it.pos().x, it.pos().y }];
+      auto entry = reference.find({ it.pos().x, it.pos().y });
+      assert(*it == (entry != reference.end() ? entry->second : '.'));
+      written += entry != reference.end();
+    }
+    assert(cells == field.chunkCount() * SparseField::ChunkSize * SparseField::ChunkSize && visits.size() == cells);
+    assert(written == reference.size());
+
+    for (char& cell : field) {
+      cell = cell == 'a' ? 'b' : cell;
+    }
+    assert(field.count('a') == 0);
+    for (auto& [key, value] : reference) {
+      value = value == 'a' ? 'b' : value;
+    }
+    assert(SparseField().begin() == SparseField().end());
+  }
+
+  // Bounds and conversion to a dense field
+  {
+    Vector min(1 << 30, 1 << 30), max(-(1 << 30), -(1 << 30));
+    for (auto& [key, value] : reference) {
+      min = Vector(std::min(min.x, key.first), std::min(min.y, key.second));
+      max = Vector(std::max(max.x, key.first), std::max(max.y, key.second));
+    }
+    assert(field.bounds() == std::make_pair(min, max));
+    auto dense = field.toField();
+    assert(dense.size == max - min + Vector(1, 1));
+    for (auto& [key, value] : reference) {
+      assert(dense[Vector(key.first, key.second) - min] == value);
+    }
+    assert(SparseField(dense, '.', min).toField().data == dense.data);
+    assert(SparseField().bounds() == std::make_pair(Vector(0, 0), Vector(-1, -1)));
+  }
+
+  // Copies are independent and a moved from field is empty
+  {
+    SparseField copy = field;
+    copy[Vector(0, 0)] = 'Z';
+    assert(field[Vector(0, 0)] != 'Z');
+    SparseField moved = std::move(copy);
+    assert(moved[Vector(0, 0)] == 'Z' && copy.chunkCount() == 0 && copy.at(Vector(0, 0), '?') == '?');
+  }
+
+  // Concurrent const reads of an unmodified field
+  {
+    std::atomic<size_t> mismatches = 0;
+    std::vector<std::pair<std::pair<int, int>, char>> entries(reference.begin(), reference.end());
+    parallel::pool().forEach(entries.size(), [&](size_t index, unsigned) {
+      auto& [key, value] = entries[index];
+      mismatches += constField[Vector(key.first, key.second)] != value;
+    });
+    assert(mismatches == 0);
+  }
+  printf("sparsefield: ok\n");
+}
@@ -0,0 +1,13 @@
+// Checks for KdTreeT and SpatialGridT on 2D points against brute force.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <cstdio>
+
+#include "../vector.hpp"
+#include "spatialchecks.hpp"
+
+int main() {
+  std::mt19937 rng(7);
+  checks::compareWithBruteForce<Vector>(rng, 60);
+  puts("spatial: ok");
+}
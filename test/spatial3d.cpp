@@ -0,0 +1,25 @@
+// Checks for KdTreeT and SpatialGridT on 3D points against brute force.
+// Build and run all checks (x64 Native Tools prompt): test\run.cmd
+
+#include <limits>
+#include <cstdio>
+
+#include "../vector3d.hpp"
+#include "spatialchecks.hpp"
+
+int main() {
+  std::mt19937 rng(7);
+  checks::compareWithBruteForce<Vector3D>(rng, 60);
+
+  // Coordinates far apart must neither overflow the grid cells nor the radius, and negative counts return nothing
+  {
+    std::vector<Vector3D> points = { Vector3D(1, 2, 3), Vector3D(-100000, 5, 7), Vector3D(2000000000, -2000000000, 0) };
+    SpatialGrid3D grid(points, 3);
+    KdTree3D tree(points);
+    auto everything = std::numeric_limits<int64_t>::max();
+    assert(grid.within(Vector3D(0, 0, 0), everything).size() == 3 && tree.within(Vector3D(0, 0, 0), everything).size() == 3);
+    assert(grid.within(Vector3D(0, 0, 0), -1).empty());
+    assert(grid.nearest(Vector3D(0, 0, 0), -5).empty() && tree.nearest(Vector3D(0, 0, 0), -5).empty());
+  }
+  puts("spatial3d: ok");
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Brute force comparison of KdTreeT and SpatialGridT, shared by the 2D (spatial.cpp) and the 3D (spatial3d.cpp) check,
+// because vector.hpp and vector3d.hpp cannot be included into the same translation unit.
+
+#include <tuple>
+#include <random>
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+#include "../spatial.hpp"
+
+namespace checks {
+  template<typename Point>
+  Point randomPoint(std::mt19937& rng, int range) {
+    auto coordinate = [&] { return static_cast<int>(rng() % range) - range / 2; };
+    if constexpr (spatial::impl::PointTraits<Point>::Dims == 2) {
+      return Point(coordinate(), coordinate());
+    } else {
+      return Point(coordinate(), coordinate(), coordinate());
+    }
+  }
+
+  /** Compares nearest(), within() and the closest pairs of both indexes with brute force on random clouds.
+   *  Small ranges produce many duplicate points and distance ties, all ranges include negative coordinates.
+   */
+  template<typename Point>
+  void compareWithBruteForce(std::mt19937& rng, int rounds) {
+    using Distance = spatial::Distance<Point>;
+    using Neighbour = spatial::NeighbourT<Distance>;
+    using PointPair = spatial::PointPairT<Distance>;
+
+    for (int round = 0; round < rounds; ++round) {
+      int count = round < 5 ? round : 1 + rng() % 400;
+      int range = 1 + rng() % (round % 3 == 0 ? 5 : 1000);
+      std::vector<Point> points;
+      for (int index = 0; index < count; ++index) {
+        points.push_back(randomPoint<Point>(rng, range));
+      }
+
+      KdTreeT<Point> tree(points);
+      SpatialGridT<Point> grid(points, round % 2 ? 0 : 1 + rng() % 50); // 0 picks the cell size from the points
+      SpatialGridT<Point> incremental(1 + rng() % 20);
+      for (auto& point : points) {
+        incremental.insert(point);
+      }
+
+      for (int query = 0; query < 30; ++query) {
+        Point position = randomPoint<Point>(rng, 2 * range + 2);
+        int neighbours = rng() % 12;
+        Distance squaredRadius = rng() % (range * range / 4 + 2);
+
+        std::vector<Neighbour> all, within;
+        for (int index = 0; index < count; ++index) {
+          Neighbour neighbour { index, spatial::squaredDistance(position, points[index]) };
+          all.push_back(neighbour);
+          if (neighbour.distance <= squaredRadius) {
+            within.push_back(neighbour);
+          }
+        }
+        std::sort(all.begin(), all.end());
+        std::sort(within.begin(), within.end());
+        all.resize(std::min<size_t>(all.size(), neighbours));
+
+        assert(tree.nearest(position, neighbours) == all && grid.nearest(position, neighbours) == all);
+        assert(incremental.nearest(position, neighbours) == all);
+        assert(tree.within(position, squaredRadius) == within && grid.within(position, squaredRadius) == within);
+        assert(incremental.within(position, squaredRadius) == within);
+      }
+
+      std::vector<PointPair> pairs;
+      for (int first = 0; first < count; ++first) {
+        for (int second = first + 1; second < count; ++second) {
+          pairs.push_back({ first, second, spatial::squaredDistance(points[first], points[second]) });
+        }
+      }
+      std::ranges::sort(pairs, [](const PointPair& a, const PointPair& b) {
+        return std::tie(a.distance, a.first, a.second) < std::tie(b.distance, b.first, b.second);
+      });
+      auto treePairs = tree.closestPairs();
+      auto gridPairs = grid.closestPairs();
+      size_t checked = round % 2 ? pairs.size() : std::min<size_t>(pairs.size(), 3 * count);
+      for (size_t index = 0; index < checked; ++index) {
+        auto treePair = treePairs.next();
+        auto gridPair = gridPairs.next();
+        assert(treePair && *treePair == pairs[index] && gridPair && *gridPair == pairs[index]);
+      }
+      if (checked == pairs.size()) {
+        assert(!treePairs.next() && !gridPairs.next());
+      }
+    }
+  }
+}
@@ -1,13 +1,17 @@
 #pragma once
 
 #include <xhash>
+#include <span>
+#include <array>
+#include <tuple>
+#include <utility>
 #include <iostream>
 #include <algorithm> // std::clamp
 
 
 namespace {
   template<typename T>
-  T pMod(T a, T b) {
+  constexpr T pMod(T a, T b) {
     auto result = a % b;
     return result < 0 ? result + b : result;
   }
@@ -16,9 +20,9 @@ namespace {
 
 template<typename T>
 struct VectorT {
-  VectorT(T x = 0, T y = 0) : x(x), y(y) {}
+  constexpr VectorT(T x = 0, T y = 0) : x(x), y(y) {}
 
-  // We sadly cannot assign the values here or use constexpr, because the class is "incomplete" at this time
+  // The constants are defined constexpr below the class, because the class is "incomplete" at this time
   static const VectorT Zero;
   static const VectorT Up;
   static const VectorT Right;
@@ -29,85 +33,79 @@ struct VectorT {
   static const VectorT DownLeft;
   static const VectorT UpLeft;
 
-  /** All simple directions */
-  static const std::initializer_list<const VectorT>& AllSimpleDirections() {
-    static const std::initializer_list<const VectorT> directions = { Up, Right, Down, Left };
-    return directions;
-  }
+  // The direction tables are compile time constants as well and thus also defined below the class.
+  // They are returned as spans, so the tables have a common type (e.g. diagonal ? AllDirections() : AllSimpleDirections())
 
-  /** All diagonal directions */
-  static const std::initializer_list<const VectorT>& AllDiagonalDirections() {
-    static const std::initializer_list<const VectorT> directions = { UpRight, DownRight, DownLeft, UpLeft };
-    return directions;
-  }
+  /** All simple directions (Up, Right, Down, Left) */
+  static constexpr std::span<const VectorT> AllSimpleDirections();
 
-  /** All directions (diagonal and simple) */
-  static const std::initializer_list<const VectorT>& AllDirections() {
-    static const std::initializer_list<const VectorT> directions = { Up, UpRight, Right, DownRight, Down, DownLeft, Left, UpLeft };
-    return directions;
-  }
+  /** All diagonal directions (UpRight, DownRight, DownLeft, UpLeft) */
+  static constexpr std::span<const VectorT> AllDiagonalDirections();
 
+  /** All directions (diagonal and simple) clockwise starting with Up */
+  static constexpr std::span<const VectorT> AllDirections();
 
-  VectorT operator+(const VectorT& other) const { return VectorT(x + other.x, y + other.y); }
-  VectorT& operator+=(const VectorT& other) {
+
+  constexpr VectorT operator+(const VectorT& other) const { return VectorT(x + other.x, y + other.y); }
+  constexpr VectorT& operator+=(const VectorT& other) {
     x += other.x;
     y += other.y;
     return *this;
   }
 
-  VectorT operator-(const VectorT& other) const { return VectorT(x - other.x, y - other.y); }
-  VectorT& operator-=(const VectorT& other) {
+  constexpr VectorT operator-(const VectorT& other) const { return VectorT(x - other.x, y - other.y); }
+  constexpr VectorT& operator-=(const VectorT& other) {
     x -= other.x;
     y -= other.y;
     return *this;
   }
 
   // Important: the following operation performs integer division!
-  VectorT operator/(T divisor) const { return VectorT(x / divisor, y / divisor); }
-  VectorT& operator/(T divisor) {
+  constexpr VectorT operator/(T divisor) const { return VectorT(x / divisor, y / divisor); }
+  constexpr VectorT& operator/(T divisor) {
     x /= divisor;
     y /= divisor;
     return *this;
   }
-  VectorT operator*(T factor) const { return VectorT(x * factor, y * factor); }
-  VectorT& operator*=(T factor) {
+  constexpr VectorT operator*(T factor) const { return VectorT(x * factor, y * factor); }
+  constexpr VectorT& operator*=(T factor) {
     x *= factor;
     y *= factor;
     return *this;
   }
 
-  VectorT operator%(T divisor) const { return VectorT(x % divisor, y % divisor); }
-  VectorT& operator%=(T divisor) {
+  constexpr VectorT operator%(T divisor) const { return VectorT(x % divisor, y % divisor); }
+  constexpr VectorT& operator%=(T divisor) {
     x %= divisor;
     y %= divisor;
     return *this;
   }
 
   // element wise modulo
-  VectorT operator%(const VectorT& other) const { return VectorT(x % other.x, y % other.y); }
-  VectorT& operator%=(const VectorT& other) {
+  constexpr VectorT operator%(const VectorT& other) const { return VectorT(x % other.x, y % other.y); }
+  constexpr VectorT& operator%=(const VectorT& other) {
     x %= other.x;
     y %= other.y;
     return *this;
   }
 
   // positive modulo
-  VectorT pMod(T divisor) const { return VectorT(::pMod(x, divisor), ::pMod(y, divisor)); }
+  constexpr VectorT pMod(T divisor) const { return VectorT(::pMod(x, divisor), ::pMod(y, divisor)); }
 
   // element wise positive modulo
-  VectorT pMod(const VectorT& other) const { return VectorT(::pMod(x, other.x), ::pMod(y, other.y)); }
+  constexpr VectorT pMod(const VectorT& other) const { return VectorT(::pMod(x, other.x), ::pMod(y, other.y)); }
 
 
-  VectorT rotateCW() const {
+  constexpr VectorT rotateCW() const {
     return VectorT(-y, x); //rotated by 90 clockwise
   }
 
-  VectorT rotateCCW() const {
+  constexpr VectorT rotateCCW() const {
     return VectorT(y, -x); //rotate by 90 counter clockwise
   }
 
   // Converts a direction vector to a character representing this direction or '0' for no direction.
-  char toChar() const {
+  constexpr char toChar() const {
     if (*this == VectorT::Zero) return '0';
     if (*this == VectorT::Left) return '<';
     if (*this == VectorT::Up) return '^';
@@ -118,7 +116,7 @@ struct VectorT {
   }
 
   // Converts a direction char into a vector (inverse of 'toChar()'). Will throw an exception if an unsupported direction is passed.
-  static VectorT fromChar(char ch) {
+  static constexpr VectorT fromChar(char ch) {
     switch (ch) {
       case '0': return VectorT::Zero;
       case '<': return VectorT::Left;
@@ -131,23 +129,28 @@ struct VectorT {
   }
 
   // Calculate the number of single steps needed to reach other from this vector
-  auto stepDistance(const VectorT& other) const {
-    return std::abs(x - other.x) + std::abs(y - other.y);
+  constexpr auto stepDistance(const VectorT& other) const {
+    return (x < other.x ? other.x - x : x - other.x) + (y < other.y ? other.y - y : y - other.y);
+  }
+
+  // Calculate the number of steps needed to reach other from this vector if diagonal steps are allowed
+  constexpr auto chebyshevDistance(const VectorT& other) const {
+    return std::max(x < other.x ? other.x - x : x - other.x, y < other.y ? other.y - y : y - other.y);
   }
 
   // Apply given functor to each component and return the result
   template<typename MapFn>
-  VectorT apply(MapFn mapFn) const { return VectorT(mapFn(x), mapFn(y)); }
+  constexpr VectorT apply(MapFn mapFn) const { return VectorT(mapFn(x), mapFn(y)); }
 
   // Performs a component wise compare and returns a result vector with -1,0,1 for each component
-  VectorT compare(const VectorT& other) const { return (*this - other).apply([](int value) { return std::clamp(value, -1, 1); }); }
+  constexpr VectorT compare(const VectorT& other) const { return (*this - other).apply([](int value) { return std::clamp(value, -1, 1); }); }
 
-  bool operator==(const VectorT& other) const = default;
-  bool operator!=(const VectorT& other) const = default;
+  constexpr bool operator==(const VectorT& other) const = default;
+  constexpr bool operator!=(const VectorT& other) const = default;
 
   // Vector ordering is defined in row major order, which makes it equal to offset ordering
   // This ordering is only defined to enable sorting vectors and using them in std::set and std::map and has no further semantic meaning
-  std::strong_ordering operator<=>(const VectorT& other) const {
+  constexpr std::strong_ordering operator<=>(const VectorT& other) const {
     auto result = (y <=> other.y);
     if (result == std::strong_ordering::equal) {
       result = x <=> other.x;
@@ -155,23 +158,81 @@ struct VectorT {
     return result;
   }
 
+  // Members for hashing::hashOf(), which would otherwise fall back to the weak std::hash specialization below
+  constexpr auto tie() const { return std::tie(x, y); }
+
   T x, y;
 };
 
 template<typename T>
-VectorT<T> operator*(T factor, const VectorT<T>& vector) {
+constexpr VectorT<T> operator*(T factor, const VectorT<T>& vector) {
   return vector * factor;
 }
 
-template<typename T> const VectorT<T> VectorT<T>::Zero(0, 0);
-template<typename T> const VectorT<T> VectorT<T>::Up(0, -1); // rows are incremented down
-template<typename T> const VectorT<T> VectorT<T>::Right(1, 0);
-template<typename T> const VectorT<T> VectorT<T>::Down(0, 1);
-template<typename T> const VectorT<T> VectorT<T>::Left(-1, 0);
-template<typename T> const VectorT<T> VectorT<T>::UpRight(1, -1);
-template<typename T> const VectorT<T> VectorT<T>::DownRight(1, 1);
-template<typename T> const VectorT<T> VectorT<T>::DownLeft(-1, 1);
-template<typename T> const VectorT<T> VectorT<T>::UpLeft(-1, -1);
+template<typename T> constexpr VectorT<T> VectorT<T>::Zero(0, 0);
+template<typename T> constexpr VectorT<T> VectorT<T>::Up(0, -1); // rows are incremented down
+template<typename T> constexpr VectorT<T> VectorT<T>::Right(1, 0);
+template<typename T> constexpr VectorT<T> VectorT<T>::Down(0, 1);
+template<typename T> constexpr VectorT<T> VectorT<T>::Left(-1, 0);
+template<typename T> constexpr VectorT<T> VectorT<T>::UpRight(1, -1);
+template<typename T> constexpr VectorT<T> VectorT<T>::DownRight(1, 1);
+template<typename T> constexpr VectorT<T> VectorT<T>::DownLeft(-1, 1);
+template<typename T> constexpr VectorT<T> VectorT<T>::UpLeft(-1, -1);
+
+namespace impl {
+  template<typename T> constexpr std::array<VectorT<T>, 4> SimpleDirections = { VectorT<T>::Up, VectorT<T>::Right, VectorT<T>::Down, VectorT<T>::Left };
+  template<typename T> constexpr std::array<VectorT<T>, 4> DiagonalDirections = { VectorT<T>::UpRight, VectorT<T>::DownRight, VectorT<T>::DownLeft, VectorT<T>::UpLeft };
+  template<typename T> constexpr std::array<VectorT<T>, 8> Directions = { VectorT<T>::Up, VectorT<T>::UpRight, VectorT<T>::Right, VectorT<T>::DownRight,
+                                                                          VectorT<T>::Down, VectorT<T>::DownLeft, VectorT<T>::Left, VectorT<T>::UpLeft };
+}
+
+template<typename T> constexpr std::span<const VectorT<T>> VectorT<T>::AllSimpleDirections() { return impl::SimpleDirections<T>; }
+template<typename T> constexpr std::span<const VectorT<T>> VectorT<T>::AllDiagonalDirections() { return impl::DiagonalDirections<T>; }
+template<typename T> constexpr std::span<const VectorT<T>> VectorT<T>::AllDirections() { return impl::Directions<T>; }
+
+
+namespace impl {
+  /** Direction table of the 4 (simple directions) or 8 (all directions) neighbourhood */
+  template<int Count, typename T>
+  constexpr const std::array<VectorT<T>, Count>& neighbourTable() {
+    static_assert(Count == 4 || Count == 8, "a 2D neighbourhood has 4 or 8 cells");
+    if constexpr (Count == 4) {
+      return SimpleDirections<T>;
+    } else {
+      return Directions<T>;
+    }
+  }
+}
+
+/** Calls fn(neighbour) for each of the 4 (or 8 including the diagonals) neighbours of pos in the order of the direction table.
+ *  The table is known at compile time, so the calls are fully unrolled.
+ */
+template<int Count = 4, typename T, typename Fn>
+constexpr void forEachNeighbour(const VectorT<T>& pos, Fn&& fn) {
+  constexpr auto& directions = impl::neighbourTable<Count, T>();
+  [&]<size_t... Index>(std::index_sequence<Index...>) {
+    (fn(pos + directions[Index]), ...);
+  }(std::make_index_sequence<Count>());
+}
+
+/** Offset deltas of the 4 (or 8) neighbours in a row major buffer with the given stride (e.g. FieldT::neighbourDeltas()) */
+template<int Count = 4>
+constexpr std::array<int, Count> neighbourDeltas(int stride) {
+  std::array<int, Count> deltas = {};
+  for (int index = 0; index < Count; ++index) {
+    auto direction = impl::neighbourTable<Count, int>()[index];
+    deltas[index] = direction.y * stride + direction.x;
+  }
+  return deltas;
+}
+
+/** Calls fn(neighbourOffset) for each of the precomputed neighbourDeltas() around offset (fully unrolled) */
+template<size_t Count, typename Fn>
+constexpr void forEachNeighbour(int offset, const std::array<int, Count>& deltas, Fn&& fn) {
+  [&]<size_t... Index>(std::index_sequence<Index...>) {
+    (fn(offset + deltas[Index]), ...);
+  }(std::make_index_sequence<Count>());
+}
 
 namespace std {
   template<typename T>
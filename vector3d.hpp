@@ -4,13 +4,17 @@
 
 
 #include <xhash>
+#include <span>
+#include <array>
+#include <tuple>
+#include <utility>
 #include <iostream>
 #include <algorithm> // std::clamp
 
 
 namespace {
   template<typename T>
-  T pMod(T a, T b) {
+  constexpr T pMod(T a, T b) {
     auto result = a % b;
     return result < 0 ? result + b : result;
   }
@@ -19,21 +23,33 @@ namespace {
 
 template<typename T>
 struct VectorT3D {
-  VectorT3D(T x = 0, T y = 0, T z = 0) : x(x), y(y), z(z) {}
+  constexpr VectorT3D(T x = 0, T y = 0, T z = 0) : x(x), y(y), z(z) {}
 
+  // The constants are defined constexpr below the class, because the class is "incomplete" at this time
   static const VectorT3D Zero;
+  // The direction tables are compile time constants as well and thus also defined below the class.
+  // They are returned as spans, so the tables have a common type
 
+  /** All simple directions along one axis (the 6 face neighbours) */
+  static constexpr std::span<const VectorT3D> AllSimpleDirections();
 
-  VectorT3D operator+(const VectorT3D& other) const { return VectorT3D(x + other.x, y + other.y, z + other.z); }
-  VectorT3D& operator+=(const VectorT3D& other) {
+  /** All directions along one or two axes (the 18 face and edge neighbours) */
+  static constexpr std::span<const VectorT3D> AllFaceAndEdgeDirections();
+
+  /** All directions including the corner diagonals (the 26 neighbours of the 3x3x3 cube) */
+  static constexpr std::span<const VectorT3D> AllDirections();
+
+
+  constexpr VectorT3D operator+(const VectorT3D& other) const { return VectorT3D(x + other.x, y + other.y, z + other.z); }
+  constexpr VectorT3D& operator+=(const VectorT3D& other) {
     x += other.x;
     y += other.y;
     z += other.z;
     return *this;
   }
 
-  VectorT3D operator-(const VectorT3D& other) const { return VectorT3D(x - other.x, y - other.y, z - other.z); }
-  VectorT3D& operator-=(const VectorT3D& other) {
+  constexpr VectorT3D operator-(const VectorT3D& other) const { return VectorT3D(x - other.x, y - other.y, z - other.z); }
+  constexpr VectorT3D& operator-=(const VectorT3D& other) {
     x -= other.x;
     y -= other.y;
     z -= other.z;
@@ -41,23 +57,23 @@ struct VectorT3D {
   }
 
   // Important: the following operation performs integer division!
-  VectorT3D operator/(T divisor) const { return VectorT3D(x / divisor, y / divisor, z / divisor); }
-  VectorT3D& operator/(T divisor) {
+  constexpr VectorT3D operator/(T divisor) const { return VectorT3D(x / divisor, y / divisor, z / divisor); }
+  constexpr VectorT3D& operator/(T divisor) {
     x /= divisor;
     y /= divisor;
     z /= divisor;
     return *this;
   }
-  VectorT3D operator*(T factor) const { return VectorT3D(x * factor, y * factor, z * factor); }
-  VectorT3D& operator*=(T factor) {
+  constexpr VectorT3D operator*(T factor) const { return VectorT3D(x * factor, y * factor, z * factor); }
+  constexpr VectorT3D& operator*=(T factor) {
     x *= factor;
     y *= factor;
     z *= factor;
     return *this;
   }
 
-  VectorT3D operator%(T divisor) const { return VectorT3D(x % divisor, y % divisor, z % divisor); }
-  VectorT3D& operator%=(T divisor) {
+  constexpr VectorT3D operator%(T divisor) const { return VectorT3D(x % divisor, y % divisor, z % divisor); }
+  constexpr VectorT3D& operator%=(T divisor) {
     x %= divisor;
     y %= divisor;
     z %= divisor;
@@ -65,8 +81,8 @@ struct VectorT3D {
   }
 
   // element wise modulo
-  VectorT3D operator%(const VectorT3D& other) const { return VectorT3D(x % other.x, y % other.y, z % other.z); }
-  VectorT3D& operator%=(const VectorT3D& other) {
+  constexpr VectorT3D operator%(const VectorT3D& other) const { return VectorT3D(x % other.x, y % other.y, z % other.z); }
+  constexpr VectorT3D& operator%=(const VectorT3D& other) {
     x %= other.x;
     y %= other.y;
     z %= other.z;
@@ -74,29 +90,29 @@ struct VectorT3D {
   }
 
   // positive modulo
-  VectorT3D pMod(T divisor) const { return VectorT3D(::pMod(x, divisor), ::pMod(y, divisor), ::pMod(z, divisor)); }
+  constexpr VectorT3D pMod(T divisor) const { return VectorT3D(::pMod(x, divisor), ::pMod(y, divisor), ::pMod(z, divisor)); }
 
   // element wise positive modulo
-  VectorT3D pMod(const VectorT3D& other) const { return VectorT3D(::pMod(x, other.x), ::pMod(y, other.y), ::pMod(z, other.z)); }
+  constexpr VectorT3D pMod(const VectorT3D& other) const { return VectorT3D(::pMod(x, other.x), ::pMod(y, other.y), ::pMod(z, other.z)); }
 
 
   // Calculate the number of single steps needed to reach other from this vector
-  auto stepDistance(const VectorT3D& other) const {
-    return std::abs(x - other.x) + std::abs(y - other.y) + std::abs(z - other.z);
+  constexpr auto stepDistance(const VectorT3D& other) const {
+    return (x < other.x ? other.x - x : x - other.x) + (y < other.y ? other.y - y : y - other.y) + (z < other.z ? other.z - z : z - other.z);
   }
 
   // Apply given functor to each component and return the result
   template<typename MapFn>
-  VectorT3D apply(MapFn mapFn) const { return VectorT3D(mapFn(x), mapFn(y), mapFn(z)); }
+  constexpr VectorT3D apply(MapFn mapFn) const { return VectorT3D(mapFn(x), mapFn(y), mapFn(z)); }
 
   // Performs a component wise compare and returns a result vector with -1,0,1 for each component
-  VectorT3D compare(const VectorT3D& other) const { return (*this - other).apply([](int value) { return std::clamp(value, -1, 1); }); }
+  constexpr VectorT3D compare(const VectorT3D& other) const { return (*this - other).apply([](int value) { return std::clamp(value, -1, 1); }); }
 
-  bool operator==(const VectorT3D& other) const = default;
-  bool operator!=(const VectorT3D& other) const = default;
+  constexpr bool operator==(const VectorT3D& other) const = default;
+  constexpr bool operator!=(const VectorT3D& other) const = default;
 
   // This ordering is only defined to enable sorting vectors and using them in std::set and std::map and has no further semantic meaning
-  std::strong_ordering operator<=>(const VectorT3D& other) const {
+  constexpr std::strong_ordering operator<=>(const VectorT3D& other) const {
     auto result = (z <=> other.z);
     if (result == std::strong_ordering::equal) {
       result = (y <=> other.y);
@@ -107,15 +123,71 @@ struct VectorT3D {
     return result;
   }
 
+  // Members for hashing::hashOf(), which would otherwise fall back to the weak std::hash specialization below
+  constexpr auto tie() const { return std::tie(x, y, z); }
+
   T x, y, z;
 };
 
 template<typename T>
-VectorT3D<T> operator*(T factor, const VectorT3D<T>& vector) {
+constexpr VectorT3D<T> operator*(T factor, const VectorT3D<T>& vector) {
   return vector * factor;
 }
 
-template<typename T> const VectorT3D<T> VectorT3D<T>::Zero(0, 0);
+template<typename T> constexpr VectorT3D<T> VectorT3D<T>::Zero(0, 0);
+
+namespace impl {
+  /** All offsets of the 3x3x3 cube around the origin, which move along 1 to maxAxes axes (ordered by z, y, x) */
+  template<typename T, size_t Count>
+  constexpr std::array<VectorT3D<T>, Count> cubeDirections(int maxAxes) {
+    std::array<VectorT3D<T>, Count> directions = {};
+    size_t index = 0;
+    for (int z = -1; z <= 1; ++z) {
+      for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+          int axes = (x != 0) + (y != 0) + (z != 0);
+          if (axes > 0 && axes <= maxAxes) {
+            directions[index++] = VectorT3D<T>(x, y, z);
+          }
+        }
+      }
+    }
+    return directions;
+  }
+
+  template<typename T> constexpr auto SimpleDirections3D = cubeDirections<T, 6>(1);
+  template<typename T> constexpr auto FaceAndEdgeDirections3D = cubeDirections<T, 18>(2);
+  template<typename T> constexpr auto Directions3D = cubeDirections<T, 26>(3);
+}
+
+template<typename T> constexpr std::span<const VectorT3D<T>> VectorT3D<T>::AllSimpleDirections() { return impl::SimpleDirections3D<T>; }
+template<typename T> constexpr std::span<const VectorT3D<T>> VectorT3D<T>::AllFaceAndEdgeDirections() { return impl::FaceAndEdgeDirections3D<T>; }
+template<typename T> constexpr std::span<const VectorT3D<T>> VectorT3D<T>::AllDirections() { return impl::Directions3D<T>; }
+
+
+namespace impl {
+  /** Direction table of the 6, 18 or 26 neighbourhood */
+  template<int Count, typename T>
+  constexpr const std::array<VectorT3D<T>, Count>& neighbourTable3D() {
+    static_assert(Count == 6 || Count == 18 || Count == 26, "a 3D neighbourhood has 6, 18 or 26 cells");
+    if constexpr (Count == 6) {
+      return SimpleDirections3D<T>;
+    } else if constexpr (Count == 18) {
+      return FaceAndEdgeDirections3D<T>;
+    } else {
+      return Directions3D<T>;
+    }
+  }
+}
+
+/** Calls fn(neighbour) for each of the 6, 18 or 26 neighbours of pos (fully unrolled at compile time) */
+template<int Count = 6, typename T, typename Fn>
+constexpr void forEachNeighbour(const VectorT3D<T>& pos, Fn&& fn) {
+  constexpr auto& directions = impl::neighbourTable3D<Count, T>();
+  [&]<size_t... Index>(std::index_sequence<Index...>) {
+    (fn(pos + directions[Index]), ...);
+  }(std::make_index_sequence<Count>());
+}
 
 namespace std {
   template<typename T>
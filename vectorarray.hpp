@@ -0,0 +1,609 @@
+#pragma once
+
+#include <new>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+// Only declared, so that this header works with vector.hpp as well as with vector3d.hpp
+template<typename T>
+struct VectorT;
+template<typename T>
+struct VectorT3D;
+
+/** Bulk kernels over the coordinate arrays of VectorArrayT and Vector3DArrayT.
+ *  32 bit integer coordinates are processed a whole SSE2/AVX2 register at a time, other types use the plain scalar loop.
+ */
+namespace soa {
+  /** Allocator for the coordinate arrays, which aligns them to cache lines */
+  template<typename T>
+  struct AlignedAllocator {
+    using value_type = T;
+    static constexpr std::align_val_t Alignment{ 64 };
+
+    AlignedAllocator() = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(::operator new(count * sizeof(T), Alignment)); }
+    void deallocate(T* pointer, size_t) { ::operator delete(pointer, Alignment); }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+  };
+
+  template<typename T>
+  using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+  /** Minimum, maximum and sum of a per element value (e.g. the step distance to a target) */
+  template<typename T>
+  struct Reduction {
+    T min;
+    T max;
+    int64_t sum;
+  };
+
+
+  namespace impl {
+#if defined(__AVX2__)
+    using Block = __m256i;
+    constexpr size_t Lanes = 8;
+
+    inline Block load(const void* data) { return _mm256_loadu_si256(static_cast<const Block*>(data)); }
+    inline void store(void* data, Block block) { _mm256_storeu_si256(static_cast<Block*>(data), block); }
+    inline Block broadcast(int32_t value) { return _mm256_set1_epi32(value); }
+    inline Block add(Block a, Block b) { return _mm256_add_epi32(a, b); }
+    inline Block subtract(Block a, Block b) { return _mm256_sub_epi32(a, b); }
+    inline Block multiply(Block a, Block b) { return _mm256_mullo_epi32(a, b); }
+    inline Block greater(Block a, Block b) { return _mm256_cmpgt_epi32(a, b); }
+    inline Block bitAnd(Block a, Block b) { return _mm256_and_si256(a, b); }
+    inline Block minimum(Block a, Block b) { return _mm256_min_epi32(a, b); }
+    inline Block maximum(Block a, Block b) { return _mm256_max_epi32(a, b); }
+    inline Block absolute(Block a) { return _mm256_abs_epi32(a); }
+    inline Block zero() { return _mm256_setzero_si256(); }
+    inline Block add64(Block a, Block b) { return _mm256_add_epi64(a, b); }
+    inline Block unpackLow(Block a, Block b) { return _mm256_unpacklo_epi32(a, b); }
+    inline Block unpackHigh(Block a, Block b) { return _mm256_unpackhi_epi32(a, b); }
+
+    /** Truncating division by multiplication with the inverse in double precision (may be off by one) */
+    inline Block divide(Block a, double inverse) {
+      __m256d factor = _mm256_set1_pd(inverse);
+      __m128i low = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(a)), factor));
+      __m128i high = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(a, 1)), factor));
+      return _mm256_set_m128i(high, low);
+    }
+#define SOA_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    using Block = __m128i;
+    constexpr size_t Lanes = 4;
+
+    inline Block load(const void* data) { return _mm_loadu_si128(static_cast<const Block*>(data)); }
+    inline void store(void* data, Block block) { _mm_storeu_si128(static_cast<Block*>(data), block); }
+    inline Block broadcast(int32_t value) { return _mm_set1_epi32(value); }
+    inline Block add(Block a, Block b) { return _mm_add_epi32(a, b); }
+    inline Block subtract(Block a, Block b) { return _mm_sub_epi32(a, b); }
+    inline Block greater(Block a, Block b) { return _mm_cmpgt_epi32(a, b); }
+    inline Block bitAnd(Block a, Block b) { return _mm_and_si128(a, b); }
+    inline Block select(Block mask, Block a, Block b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+    inline Block minimum(Block a, Block b) { return select(greater(a, b), b, a); }
+    inline Block maximum(Block a, Block b) { return select(greater(a, b), a, b); }
+    inline Block zero() { return _mm_setzero_si128(); }
+    inline Block add64(Block a, Block b) { return _mm_add_epi64(a, b); }
+    inline Block unpackLow(Block a, Block b) { return _mm_unpacklo_epi32(a, b); }
+    inline Block unpackHigh(Block a, Block b) { return _mm_unpackhi_epi32(a, b); }
+
+    inline Block absolute(Block a) {
+      Block sign = _mm_srai_epi32(a, 31);
+      return _mm_sub_epi32(_mm_xor_si128(a, sign), sign);
+    }
+
+    /** SSE2 has no 32 bit multiplication, so the even and odd lanes are multiplied separately */
+    inline Block multiply(Block a, Block b) {
+      Block even = _mm_mul_epu32(a, b);
+      Block odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+      return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    /** Truncating division by multiplication with the inverse in double precision (may be off by one) */
+    inline Block divide(Block a, double inverse) {
+      __m128d factor = _mm_set1_pd(inverse);
+      Block low = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(a), factor));
+      Block high = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(a, 8)), factor));
+      return _mm_unpacklo_epi64(low, high);
+    }
+#define SOA_SIMD 1
+#else
+#define SOA_SIMD 0
+#endif
+
+    template<typename T>
+    constexpr bool vectorizable = SOA_SIMD && std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4;
+
+    template<typename T>
+    T pMod(T value, T divisor) {
+      T result = value % divisor;
+      return result < 0 ? result + divisor : result;
+    }
+  }
+
+
+  /** values[i] += offset */
+  template<typename T>
+  void add(T* values, size_t count, T offset) {
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      auto offsets = impl::broadcast(offset);
+      for (; index + impl::Lanes <= count; index += impl::Lanes) {
+        impl::store(values + index, impl::add(impl::load(values + index), offsets));
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      values[index] += offset;
+    }
+  }
+
+  /** values[i] += others[i] * factor */
+  template<typename T>
+  void addScaled(T* values, const T* others, size_t count, T factor) {
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      auto factors = impl::broadcast(factor);
+      for (; index + impl::Lanes <= count; index += impl::Lanes) {
+        auto product = factor == 1 ? impl::load(others + index) : impl::multiply(impl::load(others + index), factors);
+        impl::store(values + index, impl::add(impl::load(values + index), product));
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      values[index] += others[index] * factor;
+    }
+  }
+
+  /** values[i] *= factor */
+  template<typename T>
+  void scale(T* values, size_t count, T factor) {
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      auto factors = impl::broadcast(factor);
+      for (; index + impl::Lanes <= count; index += impl::Lanes) {
+        impl::store(values + index, impl::multiply(impl::load(values + index), factors));
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      values[index] *= factor;
+    }
+  }
+
+  namespace impl {
+#if SOA_SIMD
+    /** Positive modulo of each lane, which divides in double precision and corrects the remainder afterwards */
+    struct PositiveModulo {
+      PositiveModulo(int32_t divisor) : inverse(1.0 / divisor), divisors(broadcast(divisor)), limit(broadcast(divisor - 1)) {}
+
+      Block operator()(Block value) const {
+        auto remainder = subtract(value, multiply(divide(value, inverse), divisors));
+        // The remainder lies within (-2 * divisor, 2 * divisor) and is moved into [0, divisor)
+        remainder = add(remainder, bitAnd(greater(zero(), remainder), divisors));
+        remainder = add(remainder, bitAnd(greater(zero(), remainder), divisors));
+        return subtract(remainder, bitAnd(greater(remainder, limit), divisors));
+      }
+
+      double inverse;
+      Block divisors, limit;
+    };
+#endif
+  }
+
+  /** values[i] = positive modulo of values[i] and the (positive) divisor.
+   *  The vectorized version divides in double precision, which requires |values[i]| + divisor < 2^31.
+   */
+  template<typename T>
+  void pMod(T* values, size_t count, T divisor) {
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      impl::PositiveModulo modulo(divisor);
+      for (; index + impl::Lanes <= count; index += impl::Lanes) {
+        impl::store(values + index, modulo(impl::load(values + index)));
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      values[index] = impl::pMod(values[index], divisor);
+    }
+  }
+
+  /** values[i] = positive modulo of (values[i] + others[i] * factor) and the divisor in a single pass (see pMod()) */
+  template<typename T>
+  void addScaledPMod(T* values, const T* others, size_t count, T factor, T divisor) {
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      impl::PositiveModulo modulo(divisor);
+      auto factors = impl::broadcast(factor);
+      for (; index + impl::Lanes <= count; index += impl::Lanes) {
+        auto product = factor == 1 ? impl::load(others + index) : impl::multiply(impl::load(others + index), factors);
+        impl::store(values + index, modulo(impl::add(impl::load(values + index), product)));
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      values[index] = impl::pMod(values[index] + others[index] * factor, divisor);
+    }
+  }
+
+  /** Smallest and largest value (count must not be zero) */
+  template<typename T>
+  std::pair<T, T> minMax(const T* values, size_t count) {
+    T min = values[0], max = values[0];
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      if (count >= impl::Lanes) {
+        auto mins = impl::load(values), maxs = mins;
+        for (index = impl::Lanes; index + impl::Lanes <= count; index += impl::Lanes) {
+          auto block = impl::load(values + index);
+          mins = impl::minimum(mins, block);
+          maxs = impl::maximum(maxs, block);
+        }
+        T lanes[2][impl::Lanes];
+        impl::store(lanes[0], mins);
+        impl::store(lanes[1], maxs);
+        min = *std::min_element(lanes[0], lanes[0] + impl::Lanes);
+        max = *std::max_element(lanes[1], lanes[1] + impl::Lanes);
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      min = std::min(min, values[index]);
+      max = std::max(max, values[index]);
+    }
+    return { min, max };
+  }
+
+  /** Counts the points (xs[i], ys[i]) in the four quadrants around center (top left, top right, bottom left, bottom right).
+   *  Points on the center row or column don't belong to any quadrant.
+   */
+  template<typename T>
+  std::array<size_t, 4> countQuadrants(const T* xs, const T* ys, size_t count, T centerX, T centerY) {
+    std::array<size_t, 4> result = {};
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      auto cx = impl::broadcast(centerX), cy = impl::broadcast(centerY);
+      impl::Block counters[4] = { impl::zero(), impl::zero(), impl::zero(), impl::zero() };
+      for (; index + impl::Lanes <= count; index += impl::Lanes) {
+        auto x = impl::load(xs + index), y = impl::load(ys + index);
+        auto left = impl::greater(cx, x), right = impl::greater(x, cx);
+        auto top = impl::greater(cy, y), bottom = impl::greater(y, cy);
+        // The masks are -1 for matching lanes
+        counters[0] = impl::subtract(counters[0], impl::bitAnd(left, top));
+        counters[1] = impl::subtract(counters[1], impl::bitAnd(right, top));
+        counters[2] = impl::subtract(counters[2], impl::bitAnd(left, bottom));
+        counters[3] = impl::subtract(counters[3], impl::bitAnd(right, bottom));
+      }
+      for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        uint32_t lanes[impl::Lanes];
+        impl::store(lanes, counters[quadrant]);
+        for (auto lane : lanes) {
+          result[quadrant] += lane;
+        }
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      if (xs[index] != centerX && ys[index] != centerY) {
+        ++result[(ys[index] > centerY) * 2 + (xs[index] > centerX)];
+      }
+    }
+    return result;
+  }
+
+  /** Minimum, maximum and sum of the step distances between the points (coordinates[0][i], coordinates[1][i], ...) and target
+   *  (count must not be zero).
+   */
+  template<typename T, size_t Dimensions>
+  Reduction<T> stepDistance(const std::array<const T*, Dimensions>& coordinates, size_t count, const std::array<T, Dimensions>& target) {
+    auto distance = [&](size_t index) {
+      T result = 0;
+      for (size_t dimension = 0; dimension < Dimensions; ++dimension) {
+        T difference = coordinates[dimension][index] - target[dimension];
+        result += difference < 0 ? -difference : difference;
+      }
+      return result;
+    };
+
+    Reduction<T> result{ distance(0), distance(0), 0 };
+    size_t index = 0;
+#if SOA_SIMD
+    if constexpr (impl::vectorizable<T>) {
+      auto mins = impl::broadcast(result.min), maxs = mins;
+      auto sums = impl::zero(), zero = impl::zero();
+      for (; index + impl::Lanes <= count; index += impl::Lanes) {
+        auto block = impl::zero();
+        for (size_t dimension = 0; dimension < Dimensions; ++dimension) {
+          auto difference = impl::subtract(impl::load(coordinates[dimension] + index), impl::broadcast(target[dimension]));
+          block = impl::add(block, impl::absolute(difference));
+        }
+        mins = impl::minimum(mins, block);
+        maxs = impl::maximum(maxs, block);
+        // Distances are non negative, so interleaving with zero widens them to 64 bit lanes
+        sums = impl::add64(sums, impl::add64(impl::unpackLow(block, zero), impl::unpackHigh(block, zero)));
+      }
+      T lanes[2][impl::Lanes];
+      int64_t sumLanes[impl::Lanes / 2];
+      impl::store(lanes[0], mins);
+      impl::store(lanes[1], maxs);
+      impl::store(sumLanes, sums);
+      result.min = *std::min_element(lanes[0], lanes[0] + impl::Lanes);
+      result.max = *std::max_element(lanes[1], lanes[1] + impl::Lanes);
+      for (auto sum : sumLanes) {
+        result.sum += sum;
+      }
+    }
+#endif
+    for (; index < count; ++index) {
+      T value = distance(index);
+      result.min = std::min(result.min, value);
+      result.max = std::max(result.max, value);
+      result.sum += value;
+    }
+    return result;
+  }
+}
+
+
+/** Structure of arrays container of 2D vectors for bulk updates of many points (e.g. moving robots), which stores the
+ *  x and y coordinates in separate aligned arrays, so that the bulk operations below are vectorized.
+ *  Single elements are read with operator[] and written with set().
+ */
+template<typename T>
+struct VectorArrayT {
+  VectorArrayT() = default;
+  explicit VectorArrayT(size_t count, const VectorT<T>& value = VectorT<T>()) : x(count, value.x), y(count, value.y) {}
+
+  VectorArrayT(const std::vector<VectorT<T>>& vectors) {
+    reserve(vectors.size());
+    for (auto& vector : vectors) {
+      push_back(vector);
+    }
+  }
+
+  std::vector<VectorT<T>> toVectors() const {
+    std::vector<VectorT<T>> result;
+    result.reserve(size());
+    for (size_t index = 0; index < size(); ++index) {
+      result.push_back((*this)[index]);
+    }
+    return result;
+  }
+
+  size_t size() const { return x.size(); }
+  bool empty() const { return x.empty(); }
+
+  void reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+  }
+
+  void resize(size_t count) {
+    x.resize(count);
+    y.resize(count);
+  }
+
+  void clear() {
+    x.clear();
+    y.clear();
+  }
+
+  void push_back(const VectorT<T>& vector) {
+    x.push_back(vector.x);
+    y.push_back(vector.y);
+  }
+
+  VectorT<T> operator[](size_t index) const { return VectorT<T>(x[index], y[index]); }
+
+  void set(size_t index, const VectorT<T>& vector) {
+    x[index] = vector.x;
+    y[index] = vector.y;
+  }
+
+
+  VectorArrayT& operator+=(const VectorT<T>& offset) {
+    soa::add(x.data(), size(), offset.x);
+    soa::add(y.data(), size(), offset.y);
+    return *this;
+  }
+
+  VectorArrayT& operator+=(const VectorArrayT& other) { return addScaled(other, 1); }
+
+  VectorArrayT& operator*=(T factor) {
+    soa::scale(x.data(), size(), factor);
+    soa::scale(y.data(), size(), factor);
+    return *this;
+  }
+
+  /** Adds other * factor to each vector (e.g. positions.addScaled(velocities, seconds)), other must have the same size */
+  VectorArrayT& addScaled(const VectorArrayT& other, T factor) {
+    soa::addScaled(x.data(), other.x.data(), size(), factor);
+    soa::addScaled(y.data(), other.y.data(), size(), factor);
+    return *this;
+  }
+
+  /** Adds other * factor to each vector and wraps the result with an element wise positive modulo in a single pass
+   *  (e.g. positions.addScaled(velocities, seconds, fieldSize) for robots, which teleport to the opposite border)
+   */
+  VectorArrayT& addScaled(const VectorArrayT& other, T factor, const VectorT<T>& divisor) {
+    soa::addScaledPMod(x.data(), other.x.data(), size(), factor, divisor.x);
+    soa::addScaledPMod(y.data(), other.y.data(), size(), factor, divisor.y);
+    return *this;
+  }
+
+  /** element wise positive modulo of each vector (e.g. wrapping positions around the field size) */
+  VectorArrayT& pMod(const VectorT<T>& divisor) {
+    soa::pMod(x.data(), size(), divisor.x);
+    soa::pMod(y.data(), size(), divisor.y);
+    return *this;
+  }
+
+  /** Returns the smallest and largest coordinates of all vectors or (Vector(0, 0), Vector(-1, -1)) if the array is empty */
+  std::pair<VectorT<T>, VectorT<T>> bounds() const {
+    if (empty()) {
+      return { VectorT<T>(0, 0), VectorT<T>(-1, -1) };
+    }
+    auto [minX, maxX] = soa::minMax(x.data(), size());
+    auto [minY, maxY] = soa::minMax(y.data(), size());
+    return { VectorT<T>(minX, minY), VectorT<T>(maxX, maxY) };
+  }
+
+  /** Number of vectors in each quadrant around center in the order top left, top right, bottom left, bottom right.
+   *  Vectors on the center row or column are not counted.
+   */
+  std::array<size_t, 4> countQuadrants(const VectorT<T>& center) const { return soa::countQuadrants(x.data(), y.data(), size(), center.x, center.y); }
+
+  /** Minimum, maximum and sum of the step distances of all vectors to target (the array must not be empty) */
+  soa::Reduction<T> stepDistance(const VectorT<T>& target) const {
+    return soa::stepDistance<T, 2>({ x.data(), y.data() }, size(), { target.x, target.y });
+  }
+
+
+  soa::AlignedVector<T> x, y;
+};
+
+using VectorArray = VectorArrayT<int>;
+
+
+/** Structure of arrays container of 3D vectors (see VectorArrayT) */
+template<typename T>
+struct Vector3DArrayT {
+  Vector3DArrayT() = default;
+  explicit Vector3DArrayT(size_t count, const VectorT3D<T>& value = VectorT3D<T>()) : x(count, value.x), y(count, value.y), z(count, value.z) {}
+
+  Vector3DArrayT(const std::vector<VectorT3D<T>>& vectors) {
+    reserve(vectors.size());
+    for (auto& vector : vectors) {
+      push_back(vector);
+    }
+  }
+
+  std::vector<VectorT3D<T>> toVectors() const {
+    std::vector<VectorT3D<T>> result;
+    result.reserve(size());
+    for (size_t index = 0; index < size(); ++index) {
+      result.push_back((*this)[index]);
+    }
+    return result;
+  }
+
+  size_t size() const { return x.size(); }
+  bool empty() const { return x.empty(); }
+
+  void reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+  }
+
+  void resize(size_t count) {
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+  }
+
+  void clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+
+  void push_back(const VectorT3D<T>& vector) {
+    x.push_back(vector.x);
+    y.push_back(vector.y);
+    z.push_back(vector.z);
+  }
+
+  VectorT3D<T> operator[](size_t index) const { return VectorT3D<T>(x[index], y[index], z[index]); }
+
+  void set(size_t index, const VectorT3D<T>& vector) {
+    x[index] = vector.x;
+    y[index] = vector.y;
+    z[index] = vector.z;
+  }
+
+
+  Vector3DArrayT& operator+=(const VectorT3D<T>& offset) {
+    soa::add(x.data(), size(), offset.x);
+    soa::add(y.data(), size(), offset.y);
+    soa::add(z.data(), size(), offset.z);
+    return *this;
+  }
+
+  Vector3DArrayT& operator+=(const Vector3DArrayT& other) { return addScaled(other, 1); }
+
+  Vector3DArrayT& operator*=(T factor) {
+    soa::scale(x.data(), size(), factor);
+    soa::scale(y.data(), size(), factor);
+    soa::scale(z.data(), size(), factor);
+    return *this;
+  }
+
+  /** Adds other * factor to each vector, other must have the same size */
+  Vector3DArrayT& addScaled(const Vector3DArrayT& other, T factor) {
+    soa::addScaled(x.data(), other.x.data(), size(), factor);
+    soa::addScaled(y.data(), other.y.data(), size(), factor);
+    soa::addScaled(z.data(), other.z.data(), size(), factor);
+    return *this;
+  }
+
+  /** Adds other * factor to each vector and wraps the result with an element wise positive modulo in a single pass */
+  Vector3DArrayT& addScaled(const Vector3DArrayT& other, T factor, const VectorT3D<T>& divisor) {
+    soa::addScaledPMod(x.data(), other.x.data(), size(), factor, divisor.x);
+    soa::addScaledPMod(y.data(), other.y.data(), size(), factor, divisor.y);
+    soa::addScaledPMod(z.data(), other.z.data(), size(), factor, divisor.z);
+    return *this;
+  }
+
+  /** element wise positive modulo of each vector */
+  Vector3DArrayT& pMod(const VectorT3D<T>& divisor) {
+    soa::pMod(x.data(), size(), divisor.x);
+    soa::pMod(y.data(), size(), divisor.y);
+    soa::pMod(z.data(), size(), divisor.z);
+    return *this;
+  }
+
+  /** Returns the smallest and largest coordinates of all vectors or (Vector3D(0, 0, 0), Vector3D(-1, -1, -1)) if the array is empty */
+  std::pair<VectorT3D<T>, VectorT3D<T>> bounds() const {
+    if (empty()) {
+      return { VectorT3D<T>(0, 0, 0), VectorT3D<T>(-1, -1, -1) };
+    }
+    auto [minX, maxX] = soa::minMax(x.data(), size());
+    auto [minY, maxY] = soa::minMax(y.data(), size());
+    auto [minZ, maxZ] = soa::minMax(z.data(), size());
+    return { VectorT3D<T>(minX, minY, minZ), VectorT3D<T>(maxX, maxY, maxZ) };
+  }
+
+  /** Minimum, maximum and sum of the step distances of all vectors to target (the array must not be empty) */
+  soa::Reduction<T> stepDistance(const VectorT3D<T>& target) const {
+    return soa::stepDistance<T, 3>({ x.data(), y.data(), z.data() }, size(), { target.x, target.y, target.z });
+  }
+
+
+  soa::AlignedVector<T> x, y, z;
+};
+
+using Vector3DArray = Vector3DArrayT<int>;